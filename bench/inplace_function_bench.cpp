@@ -0,0 +1,53 @@
+#include <archie/inplace_function.hpp>
+#include <archie/pure_function.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+namespace {
+enum { iterations = 1 << 24 };
+
+std::uint64_t twice(std::uint64_t x) { return 2 * x; }
+
+template <typename F>
+double measure(F f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double, std::nano> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+template <typename Fn>
+double call(Fn const& fn) {
+  volatile std::uint64_t sink = 0;
+  return measure([&] {
+    for (std::uint64_t idx = 0; idx < iterations; ++idx) sink = fn(idx + sink);
+  });
+}
+
+template <typename Fn>
+double construct() {
+  volatile std::uint64_t sink = 0;
+  return measure([&] {
+    for (std::uint64_t idx = 0; idx < iterations; ++idx) {
+      std::uint64_t a = idx, b = idx + 1, c = idx + 2;
+      Fn fn([a, b, c](std::uint64_t x) { return a + b + c + x; });
+      sink = fn(sink);
+    }
+  });
+}
+}
+
+int main() {
+  using std_fn = std::function<std::uint64_t(std::uint64_t)>;
+  using pure_fn = archie::pure_function<std::uint64_t(std::uint64_t)>;
+  using inplace_fn = archie::inplace_function<std::uint64_t(std::uint64_t), 32>;
+  std::printf("%16s %12s %16s\n", "", "call[ns]", "construct[ns]");
+  std::printf("%16s %12.2f %16.2f\n", "std::function", call(std_fn(twice)), construct<std_fn>());
+  std::printf("%16s %12.2f %16s\n", "pure_function", call(pure_fn(twice)), "-");
+  std::printf(
+      "%16s %12.2f %16.2f\n", "inplace_function", call(inplace_fn(twice)), construct<inplace_fn>());
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <archie/logger.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace {
+enum { rounds = 64, per_round = 1 << 14 };
+
+void format_order(std::string& out, int const& id, double const& px) {
+  out += std::to_string(id);
+  out += " @ ";
+  out += std::to_string(px);
+}
+
+template <typename Clock>
+double clock_cost(Clock clock) {
+  volatile std::uint64_t sink = 0;
+  auto const start = std::chrono::steady_clock::now();
+  for (auto idx = 0; idx < rounds * per_round; ++idx) sink = sink + clock();
+  std::chrono::duration<double, std::nano> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (rounds * per_round);
+}
+
+double log_cost(std::FILE* sink) {
+  archie::logger log(sink, per_round);
+  log.log(format_order, 0, 0.0);
+  log.flush();
+  std::chrono::duration<double, std::nano> elapsed{0};
+  for (auto r = 0; r < rounds; ++r) {
+    auto const start = std::chrono::steady_clock::now();
+    for (auto idx = 0; idx < per_round - 1; ++idx) log.log(format_order, idx, 1.5);
+    elapsed += std::chrono::steady_clock::now() - start;
+    log.flush();
+  }
+  return elapsed.count() / (rounds * (per_round - 1));
+}
+}
+
+int main() {
+  auto const sink = std::tmpfile();
+  if (sink == nullptr) return 1;
+  std::printf("%16s %12s\n", "", "call[ns]");
+  std::printf("%16s %12.2f\n", "steady_clock", clock_cost(&archie::detail::steady_ns));
+  std::printf("%16s %12.2f\n", "log_clock", clock_cost(&archie::detail::log_clock::now));
+  std::printf("%16s %12.2f\n", "logger::log", log_cost(sink));
+  std::fclose(sink);
+  return 0;
+}
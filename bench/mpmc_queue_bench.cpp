@@ -0,0 +1,70 @@
+#include <archie/container/mpmc_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+enum { items_per_producer = 1 << 18, queue_size = 1 << 10 };
+
+struct locked_queue {
+  bool try_push(int x) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (q.size() == queue_size) return false;
+    q.push(x);
+    return true;
+  }
+  bool try_pop(int& x) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (q.empty()) return false;
+    x = q.front();
+    q.pop();
+    return true;
+  }
+  std::mutex mtx;
+  std::queue<int> q;
+};
+
+template <typename Queue>
+double run(Queue& q, unsigned threads) {
+  auto const total = static_cast<long>(threads) * items_per_producer;
+  std::atomic<long> popped(0);
+  std::vector<std::thread> pool;
+  auto const start = std::chrono::steady_clock::now();
+  for (auto t = 0u; t < threads; ++t) {
+    pool.emplace_back([&q] {
+      for (auto idx = 0; idx < items_per_producer; ++idx)
+        while (!q.try_push(idx)) std::this_thread::yield();
+    });
+    pool.emplace_back([&q, &popped, total] {
+      int x = 0;
+      while (popped.load(std::memory_order_relaxed) < total) {
+        if (q.try_pop(x))
+          popped.fetch_add(1, std::memory_order_relaxed);
+        else
+          std::this_thread::yield();
+      }
+    });
+  }
+  for (auto& t : pool) t.join();
+  std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(total) / elapsed.count() / 1e6;
+}
+}
+
+int main() {
+  auto const max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::printf("%8s %16s %16s\n", "threads", "mutex [Mops/s]", "mpmc [Mops/s]");
+  for (auto threads = 1u; threads <= max_threads; threads *= 2) {
+    locked_queue lq;
+    archie::mpmc_queue<int> mq(queue_size);
+    auto const l = run(lq, threads);
+    auto const m = run(mq, threads);
+    std::printf("%8u %16.2f %16.2f\n", threads, l, m);
+  }
+  return 0;
+}
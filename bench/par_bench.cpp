@@ -0,0 +1,49 @@
+#include <archie/container/heap_buffer.hpp>
+#include <archie/par.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+enum { elements = 1 << 23 };
+
+template <typename F>
+double measure(F f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double, std::milli> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}
+
+int main() {
+  archie::heap_buffer<std::uint64_t> input(elements);
+  archie::heap_buffer<std::uint64_t> output(elements);
+  std::mt19937_64 gen(42);
+  for (auto idx = 0; idx < elements; ++idx) {
+    input.emplace_back(gen());
+    output.emplace_back(std::uint64_t(0));
+  }
+  std::printf("%8s %14s %14s %14s %14s\n", "threads", "transform[ms]", "reduce[ms]",
+              "scan[ms]", "sort[ms]");
+  for (auto threads = 1u; threads <= 32; threads *= 2) {
+    archie::thread_pool pool(threads);
+    archie::par::options opts;
+    opts.pool = &pool;
+    auto const t = measure([&] {
+      archie::par::transform(input, output, [](std::uint64_t x) { return x * x + 1; }, opts);
+    });
+    std::uint64_t sum = 0;
+    auto const r = measure([&] { sum = archie::par::reduce(input, std::uint64_t(0), opts); });
+    auto const s = measure([&] { archie::par::inclusive_scan(input, output, opts); });
+    auto const o = measure([&] {
+      archie::par::transform(input, output, [](std::uint64_t x) { return x; }, opts);
+      archie::par::sort(output, opts);
+    });
+    std::printf("%8u %14.2f %14.2f %14.2f %14.2f %s\n", threads, t, r, s, o,
+                sum == 0 ? "!" : "");
+  }
+  return 0;
+}
@@ -0,0 +1,5 @@
+BINDIR = '/usr/local/bin'
+DEFINES = ['APPNAME="sandbox"', 'VERSION="0.0.1"']
+LIBDIR = '/usr/local/lib64'
+PREFIX = '/usr/local'
+define_key = ['APPNAME', 'VERSION']
@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <archie/alias.hpp>
+#include <archie/epoch.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+template <typename T, typename Deleter = std::default_delete<T>>
+struct atomic_alias : private detail::deleter_storage<Deleter> {
+private:
+  using base_t = detail::deleter_storage<Deleter>;
+
+public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using const_reference = T const&;
+
+  struct read_guard {
+    read_guard(epoch_domain::guard g, const_pointer p) : g_(std::move(g)), p_(p) {}
+
+    const_reference operator*() const { return *p_; }
+    const_pointer operator->() const { return p_; }
+    const_pointer get() const { return p_; }
+    explicit operator bool() const { return p_ != nullptr; }
+    alias_t<T const> alias() const {
+      if (p_ == nullptr) throw std::logic_error("atomic_alias: alias of a null object");
+      return alias_t<T const>(*p_);
+    }
+
+  private:
+    epoch_domain::guard g_;
+    const_pointer p_;
+  };
+
+  explicit atomic_alias(pointer initial,
+                        epoch_domain& domain = default_epoch_domain(),
+                        Deleter del = Deleter{})
+      : base_t(std::move(del)), domain_(domain), ptr_(initial) {}
+  atomic_alias(atomic_alias const&) = delete;
+  atomic_alias& operator=(atomic_alias const&) = delete;
+  ~atomic_alias() { publish(nullptr); }
+
+  read_guard read() const {
+    auto g = domain_.pin();
+    return read_guard(std::move(g), ptr_.load(std::memory_order_acquire));
+  }
+
+  void publish(pointer next) {
+    auto const old = ptr_.exchange(next, std::memory_order_acq_rel);
+    if (old != nullptr) domain_.retire(old, this->deleter());
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    publish(new T(std::forward<Args>(args)...));
+  }
+
+  template <typename F>
+  void update(F f) {
+    auto const g = domain_.pin();
+    auto cur = ptr_.load(std::memory_order_acquire);
+    for (;;) {
+      if (cur == nullptr) throw std::logic_error("atomic_alias: update of a null object");
+      auto next = std::make_unique<T>(*cur);
+      f(*next);
+      if (ptr_.compare_exchange_weak(cur, next.get(), std::memory_order_acq_rel)) {
+        next.release();
+        domain_.retire(cur, this->deleter());
+        return;
+      }
+    }
+  }
+
+  epoch_domain& domain() const { return domain_; }
+
+private:
+  epoch_domain& domain_;
+  std::atomic<pointer> ptr_;
+};
+}
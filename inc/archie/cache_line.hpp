@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+
+namespace archie {
+static constexpr std::size_t cache_line_size = 64;
+
+template <typename T>
+struct cache_padded {
+  static_assert(sizeof(T) < cache_line_size, "");
+
+  template <typename... Args>
+  explicit cache_padded(Args&&... args)
+      : value(std::forward<Args>(args)...) {}
+
+private:
+  char front_[cache_line_size];
+
+public:
+  T value;
+
+private:
+  char back_[cache_line_size - sizeof(T)];
+};
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+#include <archie/meta/static_constexpr_storage.hpp>
+
+namespace archie {
+namespace detail {
+#if __GNUC__ < 5
+  template <typename T>
+  using trivial_default = std::has_trivial_default_constructor<T>;
+#else
+  template <typename T>
+  using trivial_default = std::is_trivially_default_constructible<T>;
+#endif
+
+  // Only empty, trivially default constructible stages fuse. C++14 closure
+  // types have no default constructor, so pipelines of lambdas are chained.
+  template <typename... Fs>
+  struct all_stateless_ : std::true_type {};
+  template <typename F, typename... Fs>
+  struct all_stateless_<F, Fs...>
+      : std::integral_constant<bool,
+                               std::is_empty<F>::value && trivial_default<F>::value &&
+                                   all_stateless_<Fs...>::value> {};
+
+  template <typename... Fs>
+  struct composed_;
+
+  template <typename F>
+  struct composed_<F> {
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+      return typename std::add_const<F>::type{}(std::forward<Args>(args)...);
+    }
+  };
+
+  template <typename F, typename... Fs>
+  struct composed_<F, Fs...> {
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+      return typename std::add_const<F>::type{}(composed_<Fs...>{}(std::forward<Args>(args)...));
+    }
+  };
+
+  template <typename... Fs>
+  struct chained_;
+
+  template <typename F>
+  struct chained_<F> {
+    explicit chained_(F f) : f_(f) {}
+
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+      return f_(std::forward<Args>(args)...);
+    }
+
+  private:
+    F f_;
+  };
+
+  template <typename F, typename... Fs>
+  struct chained_<F, Fs...> {
+    explicit chained_(F f, Fs... fs) : f_(f), rest_(fs...) {}
+
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+      return f_(rest_(std::forward<Args>(args)...));
+    }
+
+  private:
+    F f_;
+    chained_<Fs...> rest_;
+  };
+
+  struct compose_ {
+    template <typename F, typename... Fs>
+    auto operator()(F f, Fs... fs) const {
+      return make(all_stateless_<F, Fs...>{}, f, fs...);
+    }
+
+  private:
+    template <typename... Fs>
+    static composed_<Fs...> make(std::true_type, Fs...) {
+      return {};
+    }
+    template <typename... Fs>
+    static chained_<Fs...> make(std::false_type, Fs... fs) {
+      return chained_<Fs...>(fs...);
+    }
+  };
+}
+
+static constexpr auto const& compose = meta::instance<detail::compose_>();
+}
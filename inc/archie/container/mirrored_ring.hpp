@@ -0,0 +1,108 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <system_error>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <archie/posix.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+struct mirrored_ring {
+  using value_type = char;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = value_type*;
+  using const_pointer = value_type const*;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+
+  template <typename Pointer>
+  struct window {
+    Pointer begin() const { return data_; }
+    Pointer end() const { return data_ + size_; }
+    Pointer data() const { return data_; }
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    Pointer data_;
+    size_type size_;
+  };
+
+  explicit mirrored_ring(size_type n) : capacity_(round_to_page(n)) {
+    detail::fd_handle const fd(::memfd_create("archie::mirrored_ring", 0));
+    if (!fd) detail::throw_errno();
+    if (::ftruncate(*fd, static_cast<off_t>(capacity_)) != 0) detail::throw_errno();
+    auto const base =
+        ::mmap(nullptr, 2 * capacity_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) detail::throw_errno();
+    data_ = static_cast<pointer>(base);
+    for (auto half : {data_, data_ + capacity_}) {
+      if (::mmap(half, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, *fd, 0) ==
+          MAP_FAILED) {
+        auto const err = errno;
+        ::munmap(base, 2 * capacity_);
+        throw std::system_error(err, std::system_category());
+      }
+    }
+  }
+  mirrored_ring(mirrored_ring const&) = delete;
+  mirrored_ring& operator=(mirrored_ring const&) = delete;
+  ~mirrored_ring() { ::munmap(data_, 2 * capacity_); }
+
+  iterator begin() { return data_ + head_; }
+  const_iterator begin() const { return data_ + head_; }
+  iterator end() { return data_ + tail_; }
+  const_iterator end() const { return data_ + tail_; }
+
+  size_type size() const { return tail_ - head_; }
+  size_type capacity() const { return capacity_; }
+  bool empty() const { return size() == 0; }
+
+  reference operator[](size_type pos) { return begin()[pos]; }
+  const_reference operator[](size_type pos) const { return begin()[pos]; }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    if (size() == capacity()) commit(1);
+    data_[tail_++] = value_type(std::forward<Args>(args)...);
+  }
+
+  window<const_pointer> read_window() const { return {begin(), size()}; }
+  void commit(size_type n) {
+    head_ += n < size() ? n : size();
+    if (head_ >= capacity_) {
+      head_ -= capacity_;
+      tail_ -= capacity_;
+    }
+  }
+
+  window<pointer> write_window() { return {end(), capacity() - size()}; }
+  void produce(size_type n) {
+    auto const free = capacity() - size();
+    tail_ += n < free ? n : free;
+  }
+
+  size_type write(void const* src, size_type n) {
+    auto const w = write_window();
+    auto const len = n < w.size() ? n : w.size();
+    std::memcpy(w.data(), src, len);
+    produce(len);
+    return len;
+  }
+
+private:
+  static size_type round_to_page(size_type n) {
+    auto const page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    return n > 0 ? (n + page - 1) / page * page : page;
+  }
+
+  size_type const capacity_;
+  pointer data_ = nullptr;
+  size_type head_ = 0;
+  size_type tail_ = 0;
+};
+}
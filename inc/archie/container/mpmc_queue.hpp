@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+
+namespace archie {
+namespace detail {
+  inline std::size_t round_up_pow2(std::size_t n) {
+    std::size_t ret = 1;
+    while (ret < n) ret <<= 1;
+    return ret;
+  }
+
+  template <typename T>
+  struct mpmc_slot {
+    explicit mpmc_slot(std::size_t s) : sequence(s) {}
+    mpmc_slot(mpmc_slot const&) = delete;
+    mpmc_slot& operator=(mpmc_slot const&) = delete;
+
+    T* get() { return reinterpret_cast<T*>(&storage); }
+
+    std::atomic<std::size_t> sequence;
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+  };
+}
+
+template <typename T>
+struct mpmc_queue {
+private:
+  using slot_type = detail::mpmc_slot<T>;
+  using cursor_type = cache_padded<std::atomic<std::size_t>>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  explicit mpmc_queue(size_type n)
+      : slots_(detail::round_up_pow2(n > 1 ? n : 2)),
+        mask_(slots_.capacity() - 1),
+        enqueue_pos_(0),
+        dequeue_pos_(0) {
+    for (size_type idx = 0; idx < slots_.capacity(); ++idx) slots_.emplace_back(idx);
+  }
+  mpmc_queue(mpmc_queue const&) = delete;
+  mpmc_queue& operator=(mpmc_queue const&) = delete;
+  ~mpmc_queue() {
+    auto pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    auto const last = enqueue_pos_.value.load(std::memory_order_relaxed);
+    for (; pos != last; ++pos) slots_[pos & mask_].get()->~T();
+  }
+
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    auto pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& s = slots_[pos & mask_];
+      auto const seq = s.sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          new (s.get()) T(std::forward<Args>(args)...);
+          s.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool try_push(T const& x) { return try_emplace(x); }
+  bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+  bool try_pop(T& out) {
+    auto pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& s = slots_[pos & mask_];
+      auto const seq = s.sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          out = std::move(*s.get());
+          release(s, pos);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <typename OutputIt>
+  size_type try_pop_n(OutputIt out, size_type n) {
+    auto pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      size_type ready = 0;
+      while (ready < n && ready <= mask_ &&
+             slots_[(pos + ready) & mask_].sequence.load(std::memory_order_acquire) ==
+                 pos + ready + 1)
+        ++ready;
+      if (ready == 0) {
+        auto const seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) return 0;
+        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeue_pos_.value.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+        for (size_type idx = 0; idx < ready; ++idx) {
+          auto& s = slots_[(pos + idx) & mask_];
+          *out++ = std::move(*s.get());
+          release(s, pos + idx);
+        }
+        return ready;
+      }
+    }
+  }
+
+  size_type capacity() const { return mask_ + 1; }
+  size_type size() const {
+    auto const tail = dequeue_pos_.value.load(std::memory_order_relaxed);
+    auto const head = enqueue_pos_.value.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+  bool empty() const { return size() == 0; }
+
+private:
+  void release(slot_type& s, size_type pos) {
+    s.get()->~T();
+    s.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  }
+
+  heap_buffer<slot_type> slots_;
+  size_type const mask_;
+  cursor_type enqueue_pos_;
+  cursor_type dequeue_pos_;
+};
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/mpmc_queue.hpp>
+
+namespace archie {
+template <typename T>
+struct multicast_ring {
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = T const&;
+
+private:
+  using cursor_type = cache_padded<std::atomic<size_type>>;
+  struct consumer {
+    explicit consumer(std::initializer_list<size_type> d) : cursor(0), deps(d) {}
+    cursor_type cursor;
+    std::vector<size_type> deps;
+  };
+
+public:
+  explicit multicast_ring(size_type n, size_type max_consumers = 8)
+      : slots_(detail::round_up_pow2(n > 1 ? n : 2)),
+        mask_(slots_.capacity() - 1),
+        consumers_(max_consumers),
+        published_(0) {
+    for (size_type idx = 0; idx < slots_.capacity(); ++idx) slots_.emplace_back();
+  }
+  multicast_ring(multicast_ring const&) = delete;
+  multicast_ring& operator=(multicast_ring const&) = delete;
+
+  size_type capacity() const { return mask_ + 1; }
+
+  size_type add_consumer(std::initializer_list<size_type> depends_on = {}) {
+    if (consumers_.size() == consumers_.capacity())
+      throw std::length_error("multicast_ring: too many consumers");
+    for (auto d : depends_on)
+      if (d >= consumers_.size()) throw std::out_of_range("multicast_ring: unknown dependency");
+    consumers_.emplace_back(depends_on);
+    return consumers_.size() - 1;
+  }
+
+  bool try_claim(size_type n, size_type& first) {
+    if (next_ + n > gate_ + capacity()) {
+      gate_ = slowest();
+      if (next_ + n > gate_ + capacity()) return false;
+    }
+    first = next_;
+    next_ += n;
+    return true;
+  }
+
+  size_type claim(size_type n = 1) {
+    if (n > capacity()) throw std::length_error("multicast_ring: claim exceeds capacity");
+    size_type first = 0;
+    while (!try_claim(n, first)) std::this_thread::yield();
+    return first;
+  }
+
+  reference operator[](size_type seq) { return slots_[seq & mask_]; }
+  const_reference operator[](size_type seq) const { return slots_[seq & mask_]; }
+
+  void publish(size_type first, size_type n = 1) {
+    published_.value.store(first + n, std::memory_order_release);
+  }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    auto const seq = claim(1);
+    (*this)[seq] = value_type{std::forward<Args>(args)...};
+    publish(seq);
+  }
+
+  size_type published() const { return published_.value.load(std::memory_order_acquire); }
+  size_type cursor(size_type c) const {
+    return consumers_[c].cursor.value.load(std::memory_order_acquire);
+  }
+
+  size_type available(size_type c) const {
+    auto limit = published();
+    for (auto d : consumers_[c].deps) {
+      auto const dep = cursor(d);
+      if (dep < limit) limit = dep;
+    }
+    return limit - consumers_[c].cursor.value.load(std::memory_order_relaxed);
+  }
+
+  template <typename F>
+  size_type consume(size_type c, F f, size_type max_batch = size_type(-1)) {
+    auto const ready = available(c);
+    auto const n = ready < max_batch ? ready : max_batch;
+    auto& pos = consumers_[c].cursor.value;
+    auto const first = pos.load(std::memory_order_relaxed);
+    for (auto seq = first; seq != first + n; ++seq) f(static_cast<const_reference>((*this)[seq]));
+    pos.store(first + n, std::memory_order_release);
+    return n;
+  }
+
+private:
+  size_type slowest() const {
+    auto ret = next_;
+    for (auto const& c : consumers_) {
+      auto const pos = c.cursor.value.load(std::memory_order_acquire);
+      if (pos < ret) ret = pos;
+    }
+    return ret;
+  }
+
+  heap_buffer<T> slots_;
+  size_type const mask_;
+  heap_buffer<consumer> consumers_;
+  cursor_type published_;
+  size_type next_ = 0;
+  size_type gate_ = 0;
+};
+}
@@ -25,38 +25,100 @@ public:
   using value_type = typename Container::value_type;
   using size_type = typename Container::size_type;
   using difference_type = typename Container::difference_type;
+  using reference = typename Container::reference;
+  using const_reference = typename Container::const_reference;
   using iterator = ring_iterator<typename Container::iterator>;
   using const_iterator = ring_iterator<typename Container::const_iterator>;
 
   template <typename... Args>
   explicit ring_adapter(Args&&... args)
-      : container_(std::forward<Args>(args)...), pos_(container_, 0) {}
+      : container_(std::forward<Args>(args)...),
+        size_(container_.size()),
+        high_(size_),
+        low_(size_) {}
 
-  iterator begin() { return pos_; }
-  const_iterator begin() const { return iterator{container_, 0}; }
+  iterator begin() { return iterator{container_, head_}; }
+  const_iterator begin() const { return const_iterator{container_, head_}; }
   iterator end() { return begin() + size(); }
   const_iterator end() const { return begin() + size(); }
 
-  size_type size() const { return container_.size(); }
+  size_type size() const { return size_; }
   size_type capacity() const { return container_.capacity(); }
   bool empty() const { return size() == 0; }
+  bool full() const { return size() == capacity(); }
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(begin() + (size() - 1)); }
+  const_reference back() const { return *(begin() + (size() - 1)); }
 
   template <typename... Args>
   void emplace_back(Args&&... args) {
     static_assert(meta::model_of<can_emplace(Container, Args...)>::value, "");
-    if (size() != capacity()) {
+    if (container_.size() != capacity() &&
+        static_cast<size_type>(head_) + size_ == container_.size()) {
       container_.emplace_back(std::forward<Args>(args)...);
-      pos_ = iterator{container_, 0};
-    } else { *pos_++ = std::move(value_type{std::forward<Args>(args)...}); }
+      ++size_;
+    } else if (!full()) {
+      *end() = value_type{std::forward<Args>(args)...};
+      ++size_;
+    } else {
+      *begin() = value_type{std::forward<Args>(args)...};
+      advance(1);
+    }
+    if (size_ > high_) high_ = size_;
+  }
+
+  void pop_front() { consume(1); }
+  void pop_back() {
+    --size_;
+    if (size_ < low_) low_ = size_;
+  }
+
+  size_type consume(size_type n) {
+    if (n > size_) n = size_;
+    advance(n);
+    size_ -= n;
+    if (size_ < low_) low_ = size_;
+    return n;
+  }
+
+  template <typename Buffer>
+  size_type drain_into(Buffer& out) {
+    auto const room = out.max_size() - out.size();
+    auto const n = room < size_ ? room : size_;
+    auto it = begin();
+    for (size_type idx = 0; idx < n; ++idx) out.emplace_back(std::move(*it++));
+    return consume(n);
+  }
+
+  void clear() {
+    container_.clear();
+    head_ = 0;
+    size_ = 0;
+    low_ = 0;
   }
 
+  size_type high_watermark() const { return high_; }
+  size_type low_watermark() const { return low_; }
+  void reset_watermarks() { high_ = low_ = size_; }
+
   Container* operator->() { return &container_; }
   Container const* operator->() const { return &container_; }
   Container& operator*() { return container_; }
   Container const& operator*() const { return container_; }
 
 private:
+  void advance(size_type n) {
+    if (n == 0) return;
+    head_ += static_cast<difference_type>(n);
+    if (container_.size() == capacity()) head_ %= static_cast<difference_type>(capacity());
+  }
+
   Container container_;
-  iterator pos_;
+  difference_type head_ = 0;
+  size_type size_;
+  size_type high_;
+  size_type low_;
 };
 }
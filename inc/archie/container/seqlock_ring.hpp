@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <archie/container/ring_adapter.hpp>
+
+namespace archie {
+template <typename Container>
+struct seqlock_ring {
+private:
+  using ring_type = ring_adapter<Container>;
+
+public:
+  using value_type = typename ring_type::value_type;
+  using size_type = typename ring_type::size_type;
+  using pointer = value_type*;
+  static_assert(std::is_trivially_copyable<value_type>::value, "");
+
+  template <typename... Args>
+  explicit seqlock_ring(Args&&... args)
+      : ring_(std::forward<Args>(args)...) {}
+  seqlock_ring(seqlock_ring const&) = delete;
+  seqlock_ring& operator=(seqlock_ring const&) = delete;
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    auto const seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring_.emplace_back(std::forward<Args>(args)...);
+    auto const head = static_cast<size_type>(&*ring_.begin() - ring_->data());
+    head_.store(head, std::memory_order_relaxed);
+    size_.store(ring_.size(), std::memory_order_relaxed);
+    constructed_.store(ring_->size(), std::memory_order_relaxed);
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  bool try_snapshot(pointer out, size_type& n) const {
+    auto const seq = seq_.load(std::memory_order_acquire);
+    if (seq & 1) return false;
+    auto const head = head_.load(std::memory_order_relaxed);
+    auto const size = size_.load(std::memory_order_relaxed);
+    auto const constructed = constructed_.load(std::memory_order_relaxed);
+    if (size != 0) {
+      auto const first = size < constructed - head ? size : constructed - head;
+      auto const data = ring_->data();
+      std::memcpy(out, data + head, first * sizeof(value_type));
+      std::memcpy(out + first, data, (size - first) * sizeof(value_type));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq_.load(std::memory_order_relaxed) != seq) return false;
+    n = size;
+    return true;
+  }
+
+  size_type snapshot(pointer out) const {
+    size_type n = 0;
+    while (!try_snapshot(out, n)) {}
+    return n;
+  }
+
+  size_type capacity() const { return ring_.capacity(); }
+  ring_type const& ring() const { return ring_; }
+
+private:
+  ring_type ring_;
+  std::atomic<size_type> seq_{0};
+  std::atomic<size_type> head_{0};
+  std::atomic<size_type> size_{0};
+  std::atomic<size_type> constructed_{0};
+};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <archie/container/base_buffer.hpp>
+
+namespace archie {
+template <typename T>
+struct span_buffer : base_buffer<span_buffer<T>> {
+private:
+  using base_t = base_buffer<span_buffer<T>>;
+  using traits = array_traits<span_buffer<T>>;
+
+public:
+  using value_type = typename traits::value_type;
+  using pointer = typename traits::pointer;
+  using const_pointer = typename traits::const_pointer;
+  using reference = typename traits::reference;
+  using const_reference = typename traits::const_reference;
+  using size_type = typename traits::size_type;
+  using difference_type = typename traits::difference_type;
+  using iterator = typename traits::iterator;
+  using const_iterator = typename traits::const_iterator;
+
+  span_buffer(pointer p, size_type n) : base_t(p), data_(p), capacity_(n) {}
+  span_buffer(span_buffer const&) = delete;
+  span_buffer& operator=(span_buffer const&) = delete;
+  span_buffer(span_buffer&& orig)
+      : base_t(orig.end_), data_(orig.data_), capacity_(orig.capacity_) {
+    orig.data_ = nullptr;
+    orig.capacity_ = 0;
+    orig.reset();
+  }
+  ~span_buffer() { this->clear(); }
+
+  pointer data() { return data_; }
+  const_pointer data() const { return data_; }
+  size_type capacity() const { return capacity_; }
+
+private:
+  pointer data_;
+  size_type capacity_;
+};
+
+template <typename T>
+struct array_traits<span_buffer<T>> : base_factory<T> {
+  using value_type = T;
+  using pointer = value_type*;
+  using const_pointer = value_type const*;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+};
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/mpmc_queue.hpp>
+
+namespace archie {
+template <typename T>
+struct spsc_queue {
+  using value_type = T;
+  using size_type = std::size_t;
+  using pointer = T*;
+
+  explicit spsc_queue(size_type n)
+      : slots_(detail::round_up_pow2(n > 1 ? n : 2)), mask_(slots_.capacity() - 1) {
+    for (size_type idx = 0; idx < slots_.capacity(); ++idx) slots_.emplace_back();
+  }
+  spsc_queue(spsc_queue const&) = delete;
+  spsc_queue& operator=(spsc_queue const&) = delete;
+
+  pointer claim() {
+    auto const tail = tail_.value.load(std::memory_order_relaxed);
+    if (tail - head_cache_ > mask_) {
+      head_cache_ = head_.value.load(std::memory_order_acquire);
+      if (tail - head_cache_ > mask_) return nullptr;
+    }
+    return &slots_[tail & mask_];
+  }
+  void publish() {
+    tail_.value.store(tail_.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  pointer peek() {
+    auto const head = head_.value.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.value.load(std::memory_order_acquire);
+      if (head == tail_cache_) return nullptr;
+    }
+    return &slots_[head & mask_];
+  }
+  void pop() {
+    head_.value.store(head_.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  template <typename U>
+  bool try_push(U&& u) {
+    auto const slot = claim();
+    if (slot == nullptr) return false;
+    *slot = std::forward<U>(u);
+    publish();
+    return true;
+  }
+  bool try_pop(T& out) {
+    auto const slot = peek();
+    if (slot == nullptr) return false;
+    out = std::move(*slot);
+    pop();
+    return true;
+  }
+
+  size_type capacity() const { return mask_ + 1; }
+  size_type size() const {
+    auto const head = head_.value.load(std::memory_order_acquire);
+    return tail_.value.load(std::memory_order_acquire) - head;
+  }
+  bool empty() const { return size() == 0; }
+
+private:
+  heap_buffer<T> slots_;
+  size_type const mask_;
+  cache_padded<std::atomic<size_type>> head_{0};
+  size_type tail_cache_ = 0;
+  cache_padded<std::atomic<size_type>> tail_{0};
+  size_type head_cache_ = 0;
+};
+}
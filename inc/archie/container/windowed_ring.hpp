@@ -0,0 +1,133 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/ring_adapter.hpp>
+
+namespace archie {
+namespace window {
+  struct sum {};
+  struct mean {};
+  struct min {};
+  struct max {};
+}
+
+namespace detail {
+  template <typename T, typename Op>
+  struct window_op;
+
+  template <typename T>
+  struct window_op<T, window::sum> {
+    explicit window_op(std::size_t) {}
+    void on_evict(T const& x, std::size_t) { sum_ -= x; }
+    void on_push(T const& x, std::size_t) { sum_ += x; }
+    T sum() const { return sum_; }
+
+  private:
+    T sum_ = T{};
+  };
+
+  template <typename T>
+  struct window_op<T, window::mean> {
+    explicit window_op(std::size_t) {}
+    void on_evict(T const& x, std::size_t) {
+      total_ -= x;
+      --count_;
+    }
+    void on_push(T const& x, std::size_t) {
+      total_ += x;
+      ++count_;
+    }
+    double mean() const {
+      return count_ != 0 ? static_cast<double>(total_) / static_cast<double>(count_) : 0.0;
+    }
+
+  private:
+    T total_ = T{};
+    std::size_t count_ = 0;
+  };
+
+  template <typename T, typename Compare>
+  struct monotonic_window {
+    explicit monotonic_window(std::size_t n) : deque_(n) {}
+    void on_evict(T const&, std::size_t seq) {
+      if (!deque_.empty() && deque_.front().first == seq) deque_.pop_front();
+    }
+    void on_push(T const& x, std::size_t seq) {
+      while (!deque_.empty() && !Compare{}(deque_.back().second, x)) deque_.pop_back();
+      deque_.emplace_back(seq, x);
+    }
+    T const& extreme() const { return deque_.front().second; }
+
+  private:
+    ring_adapter<heap_buffer<std::pair<std::size_t, T>>> deque_;
+  };
+
+  template <typename T>
+  struct window_less {
+    bool operator()(T const& lhs, T const& rhs) const { return lhs < rhs; }
+  };
+
+  template <typename T>
+  struct window_greater {
+    bool operator()(T const& lhs, T const& rhs) const { return rhs < lhs; }
+  };
+
+  template <typename T>
+  struct window_op<T, window::min> : private monotonic_window<T, window_less<T>> {
+    using base_t = monotonic_window<T, window_less<T>>;
+    using base_t::base_t;
+    using base_t::on_evict;
+    using base_t::on_push;
+    T const& min() const { return this->extreme(); }
+  };
+
+  template <typename T>
+  struct window_op<T, window::max> : private monotonic_window<T, window_greater<T>> {
+    using base_t = monotonic_window<T, window_greater<T>>;
+    using base_t::base_t;
+    using base_t::on_evict;
+    using base_t::on_push;
+    T const& max() const { return this->extreme(); }
+  };
+}
+
+template <typename T, typename... Ops>
+struct windowed_ring : detail::window_op<T, Ops>... {
+private:
+  using ring_type = ring_adapter<heap_buffer<T>>;
+  using expand = int[];
+
+public:
+  using value_type = T;
+  using size_type = typename ring_type::size_type;
+  using const_iterator = typename ring_type::const_iterator;
+
+  explicit windowed_ring(size_type n) : detail::window_op<T, Ops>(n)..., samples_(n) {}
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    value_type x{std::forward<Args>(args)...};
+    if (samples_.full()) {
+      auto const& oldest = samples_.front();
+      auto const seq = pushed_ - samples_.size();
+      static_cast<void>(
+          expand{0, (static_cast<detail::window_op<T, Ops>&>(*this).on_evict(oldest, seq), 0)...});
+    }
+    static_cast<void>(
+        expand{0, (static_cast<detail::window_op<T, Ops>&>(*this).on_push(x, pushed_), 0)...});
+    samples_.emplace_back(std::move(x));
+    ++pushed_;
+  }
+
+  const_iterator begin() const { return samples_.begin(); }
+  const_iterator end() const { return samples_.end(); }
+  size_type size() const { return samples_.size(); }
+  size_type capacity() const { return samples_.capacity(); }
+  bool empty() const { return samples_.empty(); }
+
+private:
+  ring_type samples_;
+  std::size_t pushed_ = 0;
+};
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/mpmc_queue.hpp>
+
+namespace archie {
+template <typename T>
+struct work_stealing_deque {
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  using index_type = std::ptrdiff_t;
+
+public:
+  explicit work_stealing_deque(size_type n)
+      : slots_(detail::round_up_pow2(n > 1 ? n : 2)),
+        mask_(static_cast<index_type>(slots_.capacity() - 1)) {
+    for (size_type idx = 0; idx < slots_.capacity(); ++idx) slots_.emplace_back();
+  }
+  work_stealing_deque(work_stealing_deque const&) = delete;
+  work_stealing_deque& operator=(work_stealing_deque const&) = delete;
+
+  bool push(T const& x) {
+    auto const b = bottom_.value.load(std::memory_order_relaxed);
+    auto const t = top_.value.load(std::memory_order_acquire);
+    if (b - t > mask_) return false;
+    slots_[slot(b)] = x;
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.value.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool pop(T& out) {
+    auto const b = bottom_.value.load(std::memory_order_relaxed) - 1;
+    bottom_.value.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.value.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom_.value.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = slots_[slot(b)];
+    if (t == b) {
+      auto const won = top_.value.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.value.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  bool steal(T& out) {
+    auto t = top_.value.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const b = bottom_.value.load(std::memory_order_acquire);
+    if (t >= b) return false;
+    out = slots_[slot(t)];
+    return top_.value.compare_exchange_strong(
+        t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+  size_type capacity() const { return slots_.capacity(); }
+  size_type size() const {
+    auto const b = bottom_.value.load(std::memory_order_relaxed);
+    auto const t = top_.value.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool empty() const { return size() == 0; }
+
+private:
+  size_type slot(index_type idx) const { return static_cast<size_type>(idx & mask_); }
+
+  heap_buffer<T> slots_;
+  index_type const mask_;
+  cache_padded<std::atomic<index_type>> top_{0};
+  cache_padded<std::atomic<index_type>> bottom_{0};
+};
+}
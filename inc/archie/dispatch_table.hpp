@@ -0,0 +1,185 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <archie/meta/well_formed.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+namespace detail {
+  template <typename T, typename = meta::ignore_t>
+  struct has_count_ : std::false_type {};
+  template <typename T>
+  struct has_count_<T, meta::well_formed<decltype(T::count)>> : std::true_type {};
+
+  template <typename Enum>
+  constexpr std::size_t declared_count(std::true_type) {
+    return static_cast<std::size_t>(Enum::count);
+  }
+  template <typename Enum>
+  constexpr std::size_t declared_count(std::false_type) {
+    return 0;
+  }
+
+  template <std::size_t I, typename... Ops>
+  struct count_op_ : std::integral_constant<std::size_t, 0> {};
+  template <std::size_t I, typename Op, typename... Ops>
+  struct count_op_<I, Op, Ops...>
+      : std::integral_constant<std::size_t,
+                               (static_cast<std::size_t>(Op::opcode) == I ? 1 : 0) +
+                                   count_op_<I, Ops...>::value> {};
+
+  template <typename Seq, std::size_t Min, std::size_t Max, typename... Ops>
+  struct counts_within_ : std::true_type {};
+  template <std::size_t I, std::size_t... Is, std::size_t Min, std::size_t Max, typename... Ops>
+  struct counts_within_<std::index_sequence<I, Is...>, Min, Max, Ops...>
+      : std::conditional_t<(count_op_<I, Ops...>::value >= Min &&
+                            count_op_<I, Ops...>::value <= Max),
+                           counts_within_<std::index_sequence<Is...>, Min, Max, Ops...>,
+                           std::false_type> {};
+
+  template <std::size_t I, typename... Ops>
+  struct select_op_ {
+    using type = void;
+  };
+  template <std::size_t I, typename Op, typename... Ops>
+  struct select_op_<I, Op, Ops...>
+      : std::conditional_t<static_cast<std::size_t>(Op::opcode) == I,
+                           std::enable_if<true, Op>,
+                           select_op_<I, Ops...>> {};
+
+  template <typename Op, typename...>
+  struct first_op_ {
+    using type = Op;
+  };
+
+  template <typename Enum, typename Instr>
+  Enum opcode_of(Instr const& instr, std::true_type) {
+    return instr;
+  }
+  template <typename Enum, typename Instr>
+  Enum opcode_of(Instr const& instr, std::false_type) {
+    return instr.op;
+  }
+  template <typename Enum, typename Instr>
+  std::size_t opcode_index(Instr const& instr) {
+    return static_cast<std::size_t>(
+        opcode_of<Enum>(instr, std::is_convertible<Instr, Enum>{}));
+  }
+
+  template <typename Pointer, typename Entries, typename Seq>
+  struct dispatch_array_;
+  template <typename Pointer, typename Entries, std::size_t... I>
+  struct dispatch_array_<Pointer, Entries, std::index_sequence<I...>> {
+    static constexpr Pointer value[sizeof...(I)] = {Entries::template entry<I>()...};
+  };
+  template <typename Pointer, typename Entries, std::size_t... I>
+  constexpr Pointer dispatch_array_<Pointer, Entries, std::index_sequence<I...>>::value[];
+
+  template <typename Sig, typename... Ops>
+  struct direct_entries_;
+  template <typename R, typename... Args, typename... Ops>
+  struct direct_entries_<R(Args...), Ops...> {
+    using pointer = typename pure_function<R(Args...)>::pointer;
+
+    template <typename Op>
+    static R invoke(Args... args) {
+      return typename std::add_const<Op>::type{}(std::forward<Args>(args)...);
+    }
+
+    template <typename Op>
+    static constexpr pointer pick(std::false_type) {
+      return &invoke<Op>;
+    }
+    template <typename Op>
+    static constexpr pointer pick(std::true_type) {
+      return nullptr;
+    }
+
+    template <std::size_t I>
+    static constexpr pointer entry() {
+      using op = typename select_op_<I, Ops...>::type;
+      return pick<op>(std::is_void<op>{});
+    }
+  };
+
+  template <typename Enum, typename It, typename Rest, typename... Ops>
+  struct threaded_entries_;
+  template <typename Enum, typename It, typename... Rest, typename... Ops>
+  struct threaded_entries_<Enum, It, void(Rest...), Ops...> {
+    using pointer = It (*)(It, It, std::size_t, Rest&...);
+    using table = dispatch_array_<pointer,
+                                  threaded_entries_,
+                                  std::make_index_sequence<sizeof...(Ops)>>;
+
+    template <typename Op>
+    static It step(It it, It last, std::size_t budget, Rest&... rest) {
+      typename std::add_const<Op>::type{}(*it, rest...);
+      if (++it == last || --budget == 0) return it;
+      return table::value[opcode_index<Enum>(*it)](it, last, budget, rest...);
+    }
+
+    template <typename Op>
+    static constexpr pointer pick(std::false_type) {
+      return &step<Op>;
+    }
+    template <typename Op>
+    static constexpr pointer pick(std::true_type) {
+      return nullptr;
+    }
+
+    template <std::size_t I>
+    static constexpr pointer entry() {
+      using op = typename select_op_<I, Ops...>::type;
+      return pick<op>(std::is_void<op>{});
+    }
+  };
+}
+
+template <typename Sig, typename... Ops>
+struct dispatch_table;
+
+template <typename R, typename... Args, typename... Ops>
+struct dispatch_table<R(Args...), Ops...> {
+  using opcode_type = std::decay_t<decltype(detail::first_op_<Ops...>::type::opcode)>;
+  using pointer = typename pure_function<R(Args...)>::pointer;
+  static constexpr std::size_t size = sizeof...(Ops);
+  static constexpr std::size_t batch = 64;
+
+private:
+  using entries = detail::direct_entries_<R(Args...), Ops...>;
+  using table = detail::dispatch_array_<pointer, entries, std::make_index_sequence<size>>;
+
+  static_assert(detail::counts_within_<std::make_index_sequence<size>, 1, size, Ops...>::value,
+                "missing handler for opcode");
+  static_assert(detail::counts_within_<std::make_index_sequence<size>, 0, 1, Ops...>::value,
+                "duplicate handler for opcode");
+
+  static_assert(detail::declared_count<opcode_type>(detail::has_count_<opcode_type>{}) == 0 ||
+                    detail::declared_count<opcode_type>(detail::has_count_<opcode_type>{}) ==
+                        size,
+                "dispatch_table does not cover every opcode");
+
+public:
+  R operator()(opcode_type op, Args... args) const {
+    return table::value[static_cast<std::size_t>(op)](std::forward<Args>(args)...);
+  }
+  static constexpr pointer at(opcode_type op) {
+    return table::value[static_cast<std::size_t>(op)];
+  }
+
+  template <typename It, typename... Rest>
+  It run(It first, It last, Rest&... rest) const {
+    using threaded = detail::threaded_entries_<opcode_type, It, void(Rest...), Ops...>;
+    while (first != last)
+      first = threaded::table::value[detail::opcode_index<opcode_type>(*first)](
+          first, last, batch, rest...);
+    return first;
+  }
+};
+
+template <typename R, typename... Args, typename... Ops>
+constexpr std::size_t dispatch_table<R(Args...), Ops...>::size;
+template <typename R, typename... Args, typename... Ops>
+constexpr std::size_t dispatch_table<R(Args...), Ops...>::batch;
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <archie/cache_line.hpp>
+#include <archie/inplace_function.hpp>
+#include <archie/per_thread.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+struct epoch_domain {
+  using size_type = std::size_t;
+  using epoch_type = std::uint64_t;
+  using task = inplace_function<void(), 32, alignof(std::max_align_t), function_policy::move_only>;
+
+  static constexpr size_type backoff = 1024;
+
+private:
+  struct retired {
+    epoch_type epoch;
+    task call;
+  };
+
+  struct participant {
+    cache_padded<std::atomic<epoch_type>> state{0};
+    size_type nesting = 0;
+    size_type since_collect = 0;
+    std::vector<retired> limbo;
+  };
+
+public:
+  struct guard {
+    explicit guard(participant& p) : p_(&p) {}
+    guard(guard const&) = delete;
+    guard& operator=(guard const&) = delete;
+    guard(guard&& other) : p_(other.p_) { other.p_ = nullptr; }
+    ~guard() {
+      if (p_ != nullptr && --p_->nesting == 0) p_->state.value.store(0, std::memory_order_release);
+    }
+
+  private:
+    participant* p_;
+  };
+
+  explicit epoch_domain(size_type batch = 64, size_type limit = 0)
+      : batch_(batch > 0 ? batch : 1),
+        limit_(limit > batch_ ? limit : 16 * batch_),
+        participants_(&orphan, this) {}
+  epoch_domain(epoch_domain const&) = delete;
+  epoch_domain& operator=(epoch_domain const&) = delete;
+  ~epoch_domain() {
+    participants_.for_each([](participant& p) {
+      for (auto& r : p.limbo) r.call();
+    });
+    for (auto& r : orphans_) r.call();
+  }
+
+  guard pin() {
+    auto& p = local();
+    if (p.nesting++ == 0) {
+      p.state.value.store((global_.load(std::memory_order_relaxed) << 1) | 1,
+                          std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return guard(p);
+  }
+
+  template <typename T, typename Deleter>
+  void retire(T* ptr, Deleter del) {
+    auto& p = local();
+    p.limbo.push_back(retired{global_.load(std::memory_order_acquire),
+                              task(detail::deferred_call_<Deleter, T*>{std::move(del), ptr})});
+    if (++p.since_collect >= batch_) collect(p);
+    for (size_type n = 0; n < backoff && p.limbo.size() >= limit_ && p.nesting == 0; ++n) {
+      if (collect(p) != 0) break;
+      std::this_thread::yield();
+    }
+  }
+
+  template <typename T>
+  void retire(T* ptr) {
+    retire(ptr, std::default_delete<T>{});
+  }
+
+  size_type reclaim() { return collect(local()); }
+
+  bool try_advance() {
+    auto e = global_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto quiescent = true;
+    participants_.for_each([e, &quiescent](participant const& p) {
+      auto const s = p.state.value.load(std::memory_order_acquire);
+      if ((s & 1) != 0 && (s >> 1) != e) quiescent = false;
+    });
+    return quiescent && global_.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+  }
+
+  epoch_type epoch() const { return global_.load(std::memory_order_relaxed); }
+  size_type pending() { return local().limbo.size(); }
+
+private:
+  participant& local() { return participants_.local(); }
+
+  static void orphan(void* self, participant& p) {
+    auto& domain = *static_cast<epoch_domain*>(self);
+    p.state.value.store(0, std::memory_order_release);
+    p.nesting = 0;
+    p.since_collect = 0;
+    if (p.limbo.empty()) return;
+    std::lock_guard<std::mutex> lock(domain.orphan_mtx_);
+    for (auto& r : p.limbo) domain.orphans_.push_back(std::move(r));
+    p.limbo.clear();
+    domain.has_orphans_.store(true, std::memory_order_release);
+  }
+
+  size_type collect(participant& p) {
+    p.since_collect = 0;
+    try_advance();
+    auto const e = global_.load(std::memory_order_acquire);
+    auto it = p.limbo.begin();
+    for (; it != p.limbo.end() && it->epoch + 2 <= e; ++it) it->call();
+    auto const n = static_cast<size_type>(it - p.limbo.begin());
+    p.limbo.erase(p.limbo.begin(), it);
+    return n + sweep(e);
+  }
+
+  size_type sweep(epoch_type e) {
+    if (!has_orphans_.load(std::memory_order_acquire)) return 0;
+    std::vector<retired> safe;
+    {
+      std::lock_guard<std::mutex> lock(orphan_mtx_);
+      std::vector<retired> keep;
+      for (auto& r : orphans_) (r.epoch + 2 <= e ? safe : keep).push_back(std::move(r));
+      orphans_.swap(keep);
+      has_orphans_.store(!orphans_.empty(), std::memory_order_release);
+    }
+    for (auto& r : safe) r.call();
+    return safe.size();
+  }
+
+  size_type const batch_;
+  size_type const limit_;
+  std::atomic<epoch_type> global_{1};
+  std::atomic<bool> has_orphans_{false};
+  std::mutex orphan_mtx_;
+  std::vector<retired> orphans_;
+  detail::per_thread<participant> participants_;
+};
+
+inline epoch_domain& default_epoch_domain() {
+  static epoch_domain domain;
+  return domain;
+}
+}
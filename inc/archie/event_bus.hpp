@@ -0,0 +1,170 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/opaque.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+template <typename Event, typename Topic, std::size_t N = 4>
+struct event_bus {
+  static_assert(is_opaque<Topic>::value, "topic must be an opaque id");
+
+  using event_type = Event;
+  using topic_type = Topic;
+  using handler = pure_function<void(Event const&)>;
+  using handler_list = mixed_buffer<handler, N>;
+  using size_type = std::size_t;
+
+private:
+  struct topic_entry {
+    topic_entry(Topic const& t, size_type n) : topic(t), handlers(n) {}
+    Topic topic;
+    handler_list handlers;
+  };
+  using snapshot = heap_buffer<topic_entry>;
+
+  struct read_guard {
+    explicit read_guard(event_bus const& b) : bus(b), prev(active()) {
+      active() = this;
+      for (;;) {
+        epoch = bus.epoch_.load();
+        bus.readers_[epoch & 1].value.fetch_add(1);
+        if (bus.epoch_.load() == epoch) break;
+        bus.readers_[epoch & 1].value.fetch_sub(1);
+      }
+      current = bus.current_.load();
+    }
+    read_guard(read_guard const&) = delete;
+    read_guard& operator=(read_guard const&) = delete;
+    ~read_guard() {
+      bus.readers_[epoch & 1].value.fetch_sub(1, std::memory_order_release);
+      active() = prev;
+    }
+
+    static read_guard const*& active() {
+      static thread_local read_guard const* head = nullptr;
+      return head;
+    }
+
+    event_bus const& bus;
+    read_guard const* const prev;
+    size_type epoch = 0;
+    snapshot const* current = nullptr;
+  };
+
+public:
+  event_bus() : current_(new snapshot()) {}
+  event_bus(event_bus const&) = delete;
+  event_bus& operator=(event_bus const&) = delete;
+  ~event_bus() { delete current_.load(); }
+
+  template <typename F>
+  void subscribe(Topic const& topic, F f) {
+    handler const h{f};
+    reject_reentry();
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto const old = current_.load();
+    auto const it = find(*old, topic);
+    auto const found = it != old->end() && it->topic == topic;
+    std::unique_ptr<snapshot> next(new snapshot(old->size() + (found ? 0 : 1)));
+    for (auto x = old->begin(); x != it; ++x) next->emplace_back(*x);
+    if (found) {
+      auto& list = append(*next, topic, it->handlers.size() + 1);
+      for (auto const& y : it->handlers) list.emplace_back(y);
+      list.emplace_back(h);
+    } else {
+      append(*next, topic, 1).emplace_back(h);
+    }
+    for (auto x = found ? it + 1 : it; x != old->end(); ++x) next->emplace_back(*x);
+    replace(next.release());
+  }
+
+  template <typename F>
+  bool unsubscribe(Topic const& topic, F f) {
+    typename handler::pointer const target = handler{f};
+    reject_reentry();
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto const old = current_.load();
+    auto const it = find(*old, topic);
+    if (it == old->end() || !(it->topic == topic)) return false;
+    auto const h = std::find_if(it->handlers.begin(), it->handlers.end(), [target](handler x) {
+      return static_cast<typename handler::pointer>(x) == target;
+    });
+    if (h == it->handlers.end()) return false;
+    auto const keep = it->handlers.size() > 1;
+    std::unique_ptr<snapshot> next(new snapshot(old->size() - (keep ? 0 : 1)));
+    for (auto x = old->begin(); x != it; ++x) next->emplace_back(*x);
+    if (keep) {
+      auto& list = append(*next, topic, it->handlers.size() - 1);
+      for (auto y = it->handlers.begin(); y != it->handlers.end(); ++y)
+        if (y != h) list.emplace_back(*y);
+    }
+    for (auto x = it + 1; x != old->end(); ++x) next->emplace_back(*x);
+    replace(next.release());
+    return true;
+  }
+
+  size_type publish(Topic const& topic, Event const& e) const {
+    read_guard const guard(*this);
+    auto const it = find(*guard.current, topic);
+    if (it == guard.current->end() || !(it->topic == topic)) return 0;
+    for (auto const& h : it->handlers) h(e);
+    return it->handlers.size();
+  }
+
+  template <typename InputIt>
+  size_type publish_batch(Topic const& topic, InputIt first, InputIt last) const {
+    read_guard const guard(*this);
+    auto const it = find(*guard.current, topic);
+    if (it == guard.current->end() || !(it->topic == topic)) return 0;
+    for (auto const& h : it->handlers)
+      for (auto x = first; x != last; ++x) h(*x);
+    return it->handlers.size();
+  }
+
+  size_type subscribers(Topic const& topic) const {
+    read_guard const guard(*this);
+    auto const it = find(*guard.current, topic);
+    return it != guard.current->end() && it->topic == topic ? it->handlers.size() : 0;
+  }
+
+private:
+  // replace() waits for readers to leave; a handler mutating the bus it is
+  // being published from would wait for itself.
+  void reject_reentry() const {
+    for (auto g = read_guard::active(); g != nullptr; g = g->prev)
+      if (&g->bus == this) throw std::logic_error("event_bus: mutated from its own handler");
+  }
+
+  static handler_list& append(snapshot& s, Topic const& topic, size_type n) {
+    s.emplace_back(topic, n);
+    return s[s.size() - 1].handlers;
+  }
+
+  static typename snapshot::const_iterator find(snapshot const& s, Topic const& topic) {
+    return std::lower_bound(s.begin(), s.end(), topic, [](topic_entry const& x, Topic const& t) {
+      return x.topic < t;
+    });
+  }
+
+  void replace(snapshot* next) {
+    auto const old = current_.exchange(next);
+    auto const epoch = epoch_.fetch_add(1);
+    while (readers_[epoch & 1].value.load(std::memory_order_acquire) != 0)
+      std::this_thread::yield();
+    delete old;
+  }
+
+  std::atomic<snapshot*> current_;
+  mutable std::atomic<size_type> epoch_{0};
+  mutable cache_padded<std::atomic<size_type>> readers_[2];
+  std::mutex mtx_;
+};
+}
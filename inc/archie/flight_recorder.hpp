@@ -0,0 +1,195 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <archie/container/ring_adapter.hpp>
+#include <archie/container/span_buffer.hpp>
+#include <archie/posix.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+struct flight_event {
+  std::uint64_t timestamp;
+  std::uint32_t thread;
+  std::uint32_t code;
+  std::uint64_t args[2];
+};
+
+namespace detail {
+  struct release_flight_memory_ {
+    std::size_t count;
+    bool mapped;
+    void operator()(flight_event* p) const {
+      if (mapped)
+        ::munmap(p, count * sizeof(flight_event));
+      else
+        delete[] p;
+    }
+  };
+
+  inline flight_event* map_flight_file(std::string const& path, std::size_t count) {
+    auto const bytes = count * sizeof(flight_event);
+    fd_handle const fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+    if (!fd) throw_errno();
+    if (::ftruncate(*fd, static_cast<off_t>(bytes)) != 0) throw_errno();
+    auto const p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+    if (p == MAP_FAILED) throw_errno();
+    return static_cast<flight_event*>(p);
+  }
+
+  struct flight_ring {
+    flight_ring(std::uint32_t i, std::size_t count, std::string const& dir)
+        : id(i),
+          memory(dir.empty() ? new flight_event[count]()
+                             : map_flight_file(dir + "/flight." + std::to_string(::getpid()) +
+                                                   "." + std::to_string(i) + ".bin",
+                                               count),
+                 release_flight_memory_{count, !dir.empty()}),
+          events(*memory, count) {}
+
+    std::uint32_t const id;
+    resource<flight_event*, release_flight_memory_> memory;
+    ring_adapter<span_buffer<flight_event>> events;
+  };
+}
+
+struct flight_recorder {
+  using size_type = std::size_t;
+  using ring_type = ring_adapter<span_buffer<flight_event>>;
+
+  static constexpr size_type max_orphans = 64;
+
+  static flight_recorder& instance() {
+    static flight_recorder recorder;
+    return recorder;
+  }
+
+  void configure(size_type capacity, std::string mmap_dir = std::string()) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    capacity_ = capacity > 0 ? capacity : 1;
+    dir_ = std::move(mmap_dir);
+  }
+
+  static void record(std::uint32_t code, std::uint64_t a0 = 0, std::uint64_t a1 = 0) {
+    auto& ring = local();
+    ring.events.emplace_back(flight_event{now(), ring.id, code, {a0, a1}});
+  }
+
+  template <typename F>
+  void for_each_ring(F f) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto const r : rings_) f(r->id, static_cast<ring_type const&>(r->events));
+  }
+
+  template <typename OutputIt>
+  size_type merge(OutputIt out) const {
+    using events_type = std::vector<flight_event>;
+    using cursor = std::pair<events_type::const_iterator, events_type::const_iterator>;
+    auto const later = [](cursor const& lhs, cursor const& rhs) {
+      return lhs.first->timestamp > rhs.first->timestamp;
+    };
+    std::vector<events_type> copies;
+    std::vector<detail::flight_ring*> merged;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      for (auto const r : rings_)
+        if (!r->events.empty()) copies.emplace_back(r->events.begin(), r->events.end());
+      for (auto const r : orphans_)
+        if (!r->events.empty()) copies.emplace_back(r->events.begin(), r->events.end());
+      merged.swap(orphans_);
+    }
+    for (auto const r : merged) delete r;
+    std::vector<cursor> heap;
+    for (auto const& c : copies) heap.emplace_back(c.begin(), c.end());
+    std::make_heap(heap.begin(), heap.end(), later);
+    size_type n = 0;
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      auto& c = heap.back();
+      *out++ = *c.first++;
+      ++n;
+      if (c.first == c.second)
+        heap.pop_back();
+      else
+        std::push_heap(heap.begin(), heap.end(), later);
+    }
+    return n;
+  }
+
+  size_type dump(std::string const& path) const {
+    std::vector<flight_event> events;
+    merge(std::back_inserter(events));
+    resource<std::FILE*, close_file_> f(std::fopen(path.c_str(), "wb"), close_file_{});
+    if (*f == nullptr) detail::throw_errno();
+    if (std::fwrite(events.data(), sizeof(flight_event), events.size(), *f) != events.size())
+      detail::throw_errno();
+    return events.size();
+  }
+
+private:
+  struct close_file_ {
+    void operator()(std::FILE* f) const {
+      if (f != nullptr) std::fclose(f);
+    }
+  };
+
+  struct registration {
+    registration() : recorder(instance()), ring(recorder.attach()) {}
+    ~registration() { recorder.detach(ring); }
+    flight_recorder& recorder;
+    detail::flight_ring* ring;
+  };
+
+  flight_recorder() = default;
+  ~flight_recorder() {
+    for (auto const r : orphans_) delete r;
+  }
+
+  static std::uint64_t now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+  }
+
+  static detail::flight_ring& local() {
+    static thread_local registration reg;
+    return *reg.ring;
+  }
+
+  detail::flight_ring* attach() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    rings_.push_back(new detail::flight_ring(next_id_++, capacity_, dir_));
+    return rings_.back();
+  }
+
+  void detach(detail::flight_ring* r) {
+    detail::flight_ring* dropped = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      rings_.erase(std::remove(rings_.begin(), rings_.end(), r), rings_.end());
+      orphans_.push_back(r);
+      if (orphans_.size() > max_orphans) {
+        dropped = orphans_.front();
+        orphans_.erase(orphans_.begin());
+      }
+    }
+    delete dropped;
+  }
+
+  mutable std::mutex mtx_;
+  std::vector<detail::flight_ring*> rings_;
+  mutable std::vector<detail::flight_ring*> orphans_;
+  size_type capacity_ = 4096;
+  std::string dir_;
+  std::uint32_t next_id_ = 0;
+};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace archie {
+template <typename...>
+struct function_ref;
+
+template <typename R, typename... Args>
+struct function_ref<R(Args...)> {
+  using pointer = R (*)(Args...);
+
+private:
+  union storage {
+    void* object;
+    void (*function)();
+  };
+
+  template <typename F>
+  using enable_if_callable =
+      std::enable_if_t<!std::is_same<std::decay_t<F>, function_ref>::value>;
+
+public:
+  template <typename F, typename = enable_if_callable<F>>
+  function_ref(F&& f) {
+    bind(f, std::is_convertible<F, pointer>{});
+  }
+
+  R operator()(Args... args) const { return call_(target_, std::forward<Args>(args)...); }
+
+private:
+  template <typename F>
+  void bind(F& f, std::true_type) {
+    target_.function = reinterpret_cast<void (*)()>(static_cast<pointer>(f));
+    call_ = &call_function;
+  }
+  template <typename F>
+  void bind(F& f, std::false_type) {
+    target_.object = const_cast<void*>(static_cast<void const*>(std::addressof(f)));
+    call_ = &call_object<F>;
+  }
+
+  static R call_function(storage s, Args&&... args) {
+    return reinterpret_cast<pointer>(s.function)(std::forward<Args>(args)...);
+  }
+  template <typename F>
+  static R call_object(storage s, Args&&... args) {
+    return (*static_cast<F*>(s.object))(std::forward<Args>(args)...);
+  }
+
+  storage target_;
+  R (*call_)(storage, Args&&...);
+};
+}
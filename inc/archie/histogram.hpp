@@ -0,0 +1,183 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/ring_adapter.hpp>
+#include <archie/container/stack_buffer.hpp>
+
+namespace archie {
+template <std::size_t SubBits = 6>
+struct log_histogram {
+  static_assert(SubBits >= 2 && SubBits < 32, "");
+
+  using value_type = std::uint64_t;
+  using size_type = std::size_t;
+
+  static constexpr size_type sub_buckets = size_type(1) << SubBits;
+  static constexpr size_type half_buckets = sub_buckets / 2;
+  static constexpr size_type bucket_count = sub_buckets + (64 - SubBits) * half_buckets;
+
+  log_histogram() {
+    for (size_type idx = 0; idx < bucket_count; ++idx) buckets_.emplace_back(value_type(0));
+  }
+
+  static size_type index_of(value_type v) {
+    if (v < sub_buckets) return static_cast<size_type>(v);
+    auto const msb = static_cast<size_type>(63 - __builtin_clzll(v));
+    auto const shift = msb - SubBits + 1;
+    return sub_buckets + (shift - 1) * half_buckets + static_cast<size_type>(v >> shift) -
+           half_buckets;
+  }
+  static value_type lowest_of(size_type idx) {
+    if (idx < sub_buckets) return idx;
+    auto const shift = (idx - sub_buckets) / half_buckets + 1;
+    return value_type((idx - sub_buckets) % half_buckets + half_buckets) << shift;
+  }
+  static value_type highest_of(size_type idx) {
+    if (idx < sub_buckets) return idx;
+    auto const shift = (idx - sub_buckets) / half_buckets + 1;
+    return lowest_of(idx) + ((value_type(1) << shift) - 1);
+  }
+
+  void record(value_type v, value_type n = 1) {
+    buckets_[index_of(v)] += n;
+    count_ += n;
+    if (v < min_) min_ = v;
+    if (v > max_) max_ = v;
+  }
+
+  value_type count() const { return count_; }
+  value_type min() const { return count_ != 0 ? min_ : 0; }
+  value_type max() const { return max_; }
+  value_type operator[](size_type idx) const { return buckets_[idx]; }
+
+  value_type value_at(double percentile) const {
+    if (count_ == 0) return 0;
+    auto rank = static_cast<value_type>(percentile / 100.0 * static_cast<double>(count_) + 0.5);
+    if (rank == 0) rank = 1;
+    value_type seen = 0;
+    for (size_type idx = 0; idx < bucket_count; ++idx) {
+      seen += buckets_[idx];
+      if (seen >= rank) {
+        auto const v = highest_of(idx);
+        return v < max_ ? v : max_;
+      }
+    }
+    return max_;
+  }
+
+  log_histogram& operator+=(log_histogram const& other) {
+    for (size_type idx = 0; idx < bucket_count; ++idx) buckets_[idx] += other.buckets_[idx];
+    count_ += other.count_;
+    if (other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+    return *this;
+  }
+
+  void reset() {
+    for (auto& b : buckets_) b = 0;
+    count_ = 0;
+    min_ = ~value_type(0);
+    max_ = 0;
+  }
+
+  template <typename OutputIt>
+  OutputIt serialize(OutputIt out) const {
+    out = put(out, SubBits);
+    out = put(out, min_);
+    out = put(out, max_);
+    size_type used = 0;
+    for (auto b : buckets_) used += b != 0 ? 1 : 0;
+    out = put(out, used);
+    size_type last = 0;
+    for (size_type idx = 0; idx < bucket_count; ++idx) {
+      if (buckets_[idx] == 0) continue;
+      out = put(out, idx - last);
+      out = put(out, buckets_[idx]);
+      last = idx;
+    }
+    return out;
+  }
+
+  template <typename InputIt>
+  bool deserialize(InputIt first, InputIt last) {
+    reset();
+    value_type bits = 0, lo = 0, hi = 0, used = 0;
+    if (!get(first, last, bits) || bits != SubBits || !get(first, last, lo) ||
+        !get(first, last, hi) || !get(first, last, used))
+      return false;
+    size_type idx = 0;
+    for (value_type n = 0; n < used; ++n) {
+      value_type delta = 0, c = 0;
+      if (!get(first, last, delta) || !get(first, last, c)) return false;
+      idx += static_cast<size_type>(delta);
+      if (idx >= bucket_count) return false;
+      buckets_[idx] = c;
+      count_ += c;
+    }
+    min_ = lo;
+    max_ = hi;
+    return true;
+  }
+
+private:
+  template <typename OutputIt>
+  static OutputIt put(OutputIt out, value_type v) {
+    while (v >= 0x80) {
+      *out++ = static_cast<std::uint8_t>(v | 0x80);
+      v >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(v);
+    return out;
+  }
+  template <typename InputIt>
+  static bool get(InputIt& first, InputIt last, value_type& v) {
+    v = 0;
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7) {
+      auto const byte = static_cast<std::uint8_t>(*first++);
+      v |= value_type(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+  }
+
+  stack_buffer<value_type, bucket_count> buckets_;
+  value_type count_ = 0;
+  value_type min_ = ~value_type(0);
+  value_type max_ = 0;
+};
+
+template <std::size_t SubBits>
+constexpr std::size_t log_histogram<SubBits>::sub_buckets;
+template <std::size_t SubBits>
+constexpr std::size_t log_histogram<SubBits>::half_buckets;
+template <std::size_t SubBits>
+constexpr std::size_t log_histogram<SubBits>::bucket_count;
+
+template <std::size_t SubBits = 6>
+struct windowed_histogram {
+  using histogram_type = log_histogram<SubBits>;
+  using value_type = typename histogram_type::value_type;
+  using size_type = std::size_t;
+
+  explicit windowed_histogram(size_type intervals) : intervals_(intervals > 0 ? intervals : 1) {
+    intervals_.emplace_back();
+  }
+
+  void record(value_type v, value_type n = 1) { intervals_.back().record(v, n); }
+  void rotate() { intervals_.emplace_back(); }
+
+  histogram_type const& current() const { return intervals_.back(); }
+  histogram_type snapshot() const {
+    histogram_type ret;
+    for (auto const& h : intervals_) ret += h;
+    return ret;
+  }
+
+  size_type size() const { return intervals_.size(); }
+  size_type capacity() const { return intervals_.capacity(); }
+
+private:
+  ring_adapter<heap_buffer<histogram_type>> intervals_;
+};
+}
@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace archie {
+namespace function_policy {
+  struct copyable {};
+  struct move_only {};
+}
+
+namespace detail {
+  template <typename...>
+  struct inplace_vtable;
+
+  template <typename R, typename... Args>
+  struct inplace_vtable<R(Args...)> {
+    R (*invoke)(void*, Args&&...);
+    void (*move)(void*, void*);
+    void (*copy)(void*, void const*);
+    void (*destroy)(void*);
+  };
+
+  template <typename Sig, typename F, bool Copyable>
+  struct inplace_ops_;
+
+  template <typename R, typename... Args, typename F, bool Copyable>
+  struct inplace_ops_<R(Args...), F, Copyable> {
+    static R invoke(void* p, Args&&... args) {
+      return (*static_cast<F*>(p))(std::forward<Args>(args)...);
+    }
+    static void move(void* dst, void* src) { new (dst) F(std::move(*static_cast<F*>(src))); }
+    static void copy(void* dst, void const* src) {
+      copy(dst, src, std::integral_constant<bool, Copyable>{});
+    }
+    static void destroy(void* p) { static_cast<F*>(p)->~F(); }
+
+    static constexpr inplace_vtable<R(Args...)> value{
+        &invoke, &move, Copyable ? &copy : nullptr, &destroy};
+
+  private:
+    static void copy(void* dst, void const* src, std::true_type) {
+      new (dst) F(*static_cast<F const*>(src));
+    }
+    static void copy(void*, void const*, std::false_type) {}
+  };
+
+  template <typename R, typename... Args, typename F, bool Copyable>
+  constexpr inplace_vtable<R(Args...)> inplace_ops_<R(Args...), F, Copyable>::value;
+
+  template <typename Sig, std::size_t Capacity, std::size_t Align>
+  struct inplace_core {
+    using vtable_type = inplace_vtable<Sig>;
+
+    inplace_core() = default;
+    ~inplace_core() { reset(); }
+
+    void reset() {
+      if (vtable_ != nullptr) vtable_->destroy(&storage_);
+      vtable_ = nullptr;
+    }
+    void move_from(inplace_core& other) {
+      if (other.vtable_ == nullptr) return;
+      other.vtable_->move(&storage_, &other.storage_);
+      vtable_ = other.vtable_;
+      other.reset();
+    }
+    void copy_from(inplace_core const& other) {
+      if (other.vtable_ == nullptr) return;
+      other.vtable_->copy(&storage_, &other.storage_);
+      vtable_ = other.vtable_;
+    }
+
+    vtable_type const* vtable_ = nullptr;
+    mutable std::aligned_storage_t<Capacity, Align> storage_;
+  };
+
+  template <typename Sig, std::size_t Capacity, std::size_t Align, typename Policy>
+  struct inplace_base;
+
+  template <typename Sig, std::size_t Capacity, std::size_t Align>
+  struct inplace_base<Sig, Capacity, Align, function_policy::move_only>
+      : inplace_core<Sig, Capacity, Align> {
+    inplace_base() = default;
+    inplace_base(inplace_base&& other) : inplace_core<Sig, Capacity, Align>() {
+      this->move_from(other);
+    }
+    inplace_base& operator=(inplace_base&& other) {
+      if (this != &other) {
+        this->reset();
+        this->move_from(other);
+      }
+      return *this;
+    }
+  };
+
+  template <typename Sig, std::size_t Capacity, std::size_t Align>
+  struct inplace_base<Sig, Capacity, Align, function_policy::copyable>
+      : inplace_base<Sig, Capacity, Align, function_policy::move_only> {
+  private:
+    using base_t = inplace_base<Sig, Capacity, Align, function_policy::move_only>;
+
+  public:
+    inplace_base() = default;
+    inplace_base(inplace_base&&) = default;
+    inplace_base(inplace_base const& other) : base_t() {
+      this->copy_from(other);
+    }
+    inplace_base& operator=(inplace_base&&) = default;
+    inplace_base& operator=(inplace_base const& other) {
+      if (this != &other) {
+        this->reset();
+        this->copy_from(other);
+      }
+      return *this;
+    }
+  };
+}
+
+template <typename Sig,
+          std::size_t Capacity = 32,
+          std::size_t Align = alignof(std::max_align_t),
+          typename Policy = function_policy::copyable>
+struct inplace_function;
+
+template <typename R, typename... Args, std::size_t Capacity, std::size_t Align, typename Policy>
+struct inplace_function<R(Args...), Capacity, Align, Policy>
+    : private detail::inplace_base<R(Args...), Capacity, Align, Policy> {
+private:
+  static constexpr bool copyable = std::is_same<Policy, function_policy::copyable>::value;
+
+  template <typename F>
+  using enable_if_callable =
+      std::enable_if_t<!std::is_same<std::decay_t<F>, inplace_function>::value>;
+
+public:
+  inplace_function() = default;
+  inplace_function(std::nullptr_t) {}
+
+  template <typename F, typename = enable_if_callable<F>>
+  explicit inplace_function(F&& f) {
+    emplace(std::forward<F>(f));
+  }
+
+  template <typename F, typename = enable_if_callable<F>>
+  inplace_function& operator=(F&& f) {
+    this->reset();
+    emplace(std::forward<F>(f));
+    return *this;
+  }
+  inplace_function& operator=(std::nullptr_t) {
+    this->reset();
+    return *this;
+  }
+
+  R operator()(Args... args) const {
+    if (this->vtable_ == nullptr) throw std::bad_function_call();
+    return this->vtable_->invoke(&this->storage_, std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const { return this->vtable_ != nullptr; }
+
+private:
+  template <typename F>
+  void emplace(F&& f) {
+    using type = std::decay_t<F>;
+    static_assert(sizeof(type) <= Capacity, "callable does not fit inplace_function");
+    static_assert(Align % alignof(type) == 0, "callable is over-aligned for inplace_function");
+    static_assert(!copyable || std::is_copy_constructible<type>::value,
+                  "callable must be copy constructible");
+    new (&this->storage_) type(std::forward<F>(f));
+    this->vtable_ = &detail::inplace_ops_<R(Args...), type, copyable>::value;
+  }
+};
+
+template <typename R, typename... Args, std::size_t Capacity, std::size_t Align, typename Policy>
+constexpr bool inplace_function<R(Args...), Capacity, Align, Policy>::copyable;
+}
@@ -0,0 +1,401 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/posix.hpp>
+#include <archie/pure_function.hpp>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define ARCHIE_HAS_IO_URING 1
+#endif
+#endif
+
+namespace archie {
+enum class io_backend { automatic, uring, sync };
+
+struct fixed_file {
+  unsigned index;
+};
+
+struct io_ring {
+  using completion = pure_function<void(std::uint64_t, long)>;
+  using size_type = std::size_t;
+
+private:
+  enum class opcode : std::uint8_t { read, write };
+
+  struct request {
+    opcode op;
+    int fd;
+    bool fixed_fd;
+    int buffer;
+    void* data;
+    std::uint32_t length;
+    std::uint64_t offset;
+    std::uint32_t slot;
+  };
+
+  struct slot {
+    completion cb;
+    std::uint64_t user = 0;
+    std::uint32_t next = 0;
+  };
+
+  struct finished {
+    completion cb;
+    std::uint64_t user;
+    long result;
+  };
+
+  static constexpr std::uint32_t npos = ~std::uint32_t(0);
+
+public:
+  explicit io_ring(unsigned depth = 128,
+                   unsigned batch = 32,
+                   io_backend backend = io_backend::automatic)
+      : depth_(depth > 0 ? depth : 1), batch_(batch > 0 ? batch : 1) {
+    auto err = ENOSYS;
+#ifdef ARCHIE_HAS_IO_URING
+    if (backend != io_backend::sync) err = setup_uring();
+#endif
+    if (backend == io_backend::uring && !ring_fd_)
+      throw std::system_error(err, std::system_category());
+    auto const slots = 2 * depth_;
+    slots_ = heap_buffer<slot>(slots);
+    for (std::uint32_t idx = 0; idx < slots; ++idx) {
+      slots_.emplace_back();
+      slots_[idx].next = idx + 1 < slots ? idx + 1 : npos;
+    }
+    free_ = 0;
+    pending_ = heap_buffer<request>(depth_);
+    done_ = heap_buffer<std::pair<std::uint32_t, long>>(slots);
+    ready_.reserve(slots);
+  }
+  io_ring(io_ring const&) = delete;
+  io_ring& operator=(io_ring const&) = delete;
+  ~io_ring() { drain(); }
+
+  bool uses_uring() const { return static_cast<bool>(ring_fd_); }
+  unsigned depth() const { return depth_; }
+  unsigned batch() const { return batch_; }
+  size_type in_flight() const { return in_flight_; }
+
+  void read(int fd, void* data, size_type n, std::uint64_t offset, completion cb,
+            std::uint64_t user = 0) {
+    queue(request{opcode::read, fd, false, -1, data, length(n), offset, 0}, cb, user);
+  }
+  void read(fixed_file f, void* data, size_type n, std::uint64_t offset, completion cb,
+            std::uint64_t user = 0) {
+    queue(request{opcode::read, fd_of(f), uses_uring(), -1, data, length(n), offset, 0},
+          cb,
+          user);
+  }
+  void write(int fd, void const* data, size_type n, std::uint64_t offset, completion cb,
+             std::uint64_t user = 0) {
+    queue(request{opcode::write, fd, false, -1, const_cast<void*>(data), length(n), offset, 0},
+          cb,
+          user);
+  }
+  void read_fixed(int fd, unsigned buffer, void* data, size_type n, std::uint64_t offset,
+                  completion cb, std::uint64_t user = 0) {
+    queue(request{opcode::read, fd, false, static_cast<int>(buffer), data, length(n), offset, 0},
+          cb,
+          user);
+  }
+
+  void register_files(int const* fds, unsigned n) {
+    files_ = heap_buffer<int>(n);
+    for (unsigned idx = 0; idx < n; ++idx) files_.emplace_back(fds[idx]);
+#ifdef ARCHIE_HAS_IO_URING
+    if (uses_uring() && reg(IORING_REGISTER_FILES, fds, n) < 0) detail::throw_errno();
+#endif
+  }
+
+  void register_buffers(iovec const* buffers, unsigned n) {
+#ifdef ARCHIE_HAS_IO_URING
+    if (uses_uring() && reg(IORING_REGISTER_BUFFERS, buffers, n) < 0) detail::throw_errno();
+#else
+    static_cast<void>(buffers);
+    static_cast<void>(n);
+#endif
+  }
+
+  size_type submit() {
+    auto const n = pending_.size() + to_submit_;
+    if (n == 0) return 0;
+    if (uses_uring())
+      enter(0);
+    else
+      run_pending();
+    return n;
+  }
+
+  size_type poll() {
+    if (uses_uring()) reap();
+    auto const n = retire();
+    dispatch();
+    return n;
+  }
+
+  size_type wait(size_type min = 1) {
+    size_type ret = 0;
+    if (!uses_uring()) {
+      run_pending();
+      ret = retire();
+    } else {
+      for (;;) {
+        reap();
+        ret += retire();
+        if (ret >= min || in_flight_ == 0) break;
+        enter(static_cast<unsigned>(min - ret < in_flight_ ? min - ret : in_flight_));
+      }
+    }
+    dispatch();
+    return ret;
+  }
+
+  size_type drain() {
+    size_type ret = 0;
+    while (in_flight_ != 0) ret += wait(in_flight_);
+    return ret;
+  }
+
+private:
+  static std::uint32_t length(size_type n) {
+    if (n > std::numeric_limits<std::uint32_t>::max())
+      throw std::length_error("io_ring: request length exceeds 32 bits");
+    return static_cast<std::uint32_t>(n);
+  }
+  int fd_of(fixed_file f) const {
+    return uses_uring() ? static_cast<int>(f.index) : files_[f.index];
+  }
+
+  void queue(request r, completion cb, std::uint64_t user) {
+    while (free_ == npos) wait(1);
+    auto const idx = free_;
+    free_ = slots_[idx].next;
+    slots_[idx].cb = cb;
+    slots_[idx].user = user;
+    r.slot = idx;
+    ++in_flight_;
+    if (uses_uring()) {
+      push_sqe(r);
+      if (to_submit_ >= batch_) submit();
+    } else {
+      pending_.emplace_back(r);
+      if (pending_.size() >= batch_ || pending_.size() == pending_.capacity()) run_pending();
+    }
+  }
+
+  void run_pending() {
+    for (auto const& r : pending_) {
+      auto res = r.op == opcode::read
+                     ? ::pread(r.fd, r.data, r.length, static_cast<off_t>(r.offset))
+                     : ::pwrite(r.fd, r.data, r.length, static_cast<off_t>(r.offset));
+      if (res < 0) res = -errno;
+      done_.emplace_back(r.slot, static_cast<long>(res));
+    }
+    pending_.clear();
+  }
+
+  size_type retire() {
+    for (auto const& d : done_) {
+      auto& s = slots_[d.first];
+      ready_.push_back(finished{s.cb, s.user, d.second});
+      s.cb = nullptr;
+      s.next = free_;
+      free_ = d.first;
+      --in_flight_;
+    }
+    auto const n = done_.size();
+    done_.clear();
+    return n;
+  }
+
+  // Callbacks may queue more requests, which can retire further completions
+  // into ready_; only the outermost call runs callbacks so none are lost.
+  void dispatch() {
+    if (dispatching_) return;
+    dispatching_ = true;
+    size_type idx = 0;
+    try {
+      for (; idx < ready_.size(); ++idx) {
+        auto const f = ready_[idx];
+        if (f.cb) f.cb(f.user, f.result);
+      }
+    } catch (...) {
+      ready_.erase(ready_.begin(), ready_.begin() + static_cast<std::ptrdiff_t>(idx + 1));
+      dispatching_ = false;
+      throw;
+    }
+    ready_.clear();
+    dispatching_ = false;
+  }
+
+#ifdef ARCHIE_HAS_IO_URING
+  static unsigned load(unsigned const* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+  static void store(unsigned* p, unsigned v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+
+  template <typename T>
+  T* at(detail::mapping_handle const& m, std::uint32_t offset) const {
+    return reinterpret_cast<T*>(static_cast<char*>(*m) + offset);
+  }
+
+  int reg(unsigned op, void const* arg, unsigned n) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, *ring_fd_, op, arg, n));
+  }
+
+  static detail::mapping_handle map(int fd, size_type bytes, off_t offset) {
+    auto const p =
+        ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (p == MAP_FAILED) detail::throw_errno();
+    return detail::mapping_handle(p, detail::unmap_{bytes});
+  }
+
+  // Plain IORING_OP_READ and IORING_OP_WRITE need Linux 5.6, the same release
+  // that added IORING_REGISTER_PROBE; older kernels fail the probe.
+  static bool supports_ops(int fd) {
+    alignas(io_uring_probe) unsigned char buf[sizeof(io_uring_probe) +
+                                              256 * sizeof(io_uring_probe_op)];
+    std::memset(buf, 0, sizeof(buf));
+    if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, buf, 256) < 0) return false;
+    auto const probe = reinterpret_cast<io_uring_probe const*>(buf);
+    auto const ops = reinterpret_cast<io_uring_probe_op const*>(buf + sizeof(io_uring_probe));
+    auto const supported = [probe, ops](unsigned op) {
+      return op < probe->ops_len && (ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+    };
+    return supported(IORING_OP_READ) && supported(IORING_OP_WRITE) &&
+           supported(IORING_OP_READ_FIXED);
+  }
+
+  int setup_uring() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    detail::fd_handle fd(static_cast<int>(::syscall(__NR_io_uring_setup, depth_, &params)));
+    if (!fd) return errno;
+    if (!supports_ops(*fd)) return EOPNOTSUPP;
+    auto const sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    auto const cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      sq_map_ = map(*fd, sq_bytes > cq_bytes ? sq_bytes : cq_bytes, IORING_OFF_SQ_RING);
+    } else {
+      sq_map_ = map(*fd, sq_bytes, IORING_OFF_SQ_RING);
+      cq_map_ = map(*fd, cq_bytes, IORING_OFF_CQ_RING);
+    }
+    sqe_map_ = map(*fd, params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+    auto const& cq = cq_map_ ? cq_map_ : sq_map_;
+
+    sq_head_ = at<unsigned>(sq_map_, params.sq_off.head);
+    sq_tail_ = at<unsigned>(sq_map_, params.sq_off.tail);
+    sq_mask_ = *at<unsigned>(sq_map_, params.sq_off.ring_mask);
+    sq_array_ = at<unsigned>(sq_map_, params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    sqes_ = static_cast<io_uring_sqe*>(*sqe_map_);
+    cq_head_ = at<unsigned>(cq, params.cq_off.head);
+    cq_tail_ = at<unsigned>(cq, params.cq_off.tail);
+    cq_mask_ = *at<unsigned>(cq, params.cq_off.ring_mask);
+    cqes_ = at<io_uring_cqe>(cq, params.cq_off.cqes);
+    tail_ = *sq_tail_;
+    depth_ = params.sq_entries;
+    ring_fd_ = std::move(fd);
+    return 0;
+  }
+
+  void push_sqe(request const& r) {
+    while (tail_ - load(sq_head_) == sq_entries_) enter(0);
+    auto const idx = tail_ & sq_mask_;
+    auto& sqe = sqes_[idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    if (r.buffer >= 0) {
+      sqe.opcode = r.op == opcode::read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+      sqe.buf_index = static_cast<std::uint16_t>(r.buffer);
+    } else {
+      sqe.opcode = r.op == opcode::read ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+    if (r.fixed_fd) sqe.flags = IOSQE_FIXED_FILE;
+    sqe.fd = r.fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(r.data);
+    sqe.len = r.length;
+    sqe.off = r.offset;
+    sqe.user_data = r.slot;
+    sq_array_[idx] = idx;
+    ++tail_;
+    ++to_submit_;
+  }
+
+  void enter(unsigned min_complete) {
+    store(sq_tail_, tail_);
+    auto const flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u;
+    for (;;) {
+      auto const ret = ::syscall(
+          __NR_io_uring_enter, *ring_fd_, to_submit_, min_complete, flags, nullptr, 0);
+      if (ret >= 0) {
+        to_submit_ -= static_cast<unsigned>(ret);
+        return;
+      }
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EBUSY) {
+        reap();
+        return;
+      }
+      detail::throw_errno();
+    }
+  }
+
+  void reap() {
+    auto head = *cq_head_;
+    auto const tail = load(cq_tail_);
+    for (; head != tail; ++head) {
+      auto const& cqe = cqes_[head & cq_mask_];
+      done_.emplace_back(static_cast<std::uint32_t>(cqe.user_data), static_cast<long>(cqe.res));
+    }
+    store(cq_head_, head);
+  }
+#else
+  void push_sqe(request const&) {}
+  void enter(unsigned) {}
+  void reap() {}
+#endif
+
+  unsigned depth_;
+  unsigned const batch_;
+  detail::fd_handle ring_fd_;
+  detail::mapping_handle sq_map_;
+  detail::mapping_handle cq_map_;
+  detail::mapping_handle sqe_map_;
+#ifdef ARCHIE_HAS_IO_URING
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+  unsigned tail_ = 0;
+#endif
+  unsigned to_submit_ = 0;
+  size_type in_flight_ = 0;
+  std::uint32_t free_ = npos;
+  heap_buffer<slot> slots_;
+  heap_buffer<request> pending_;
+  heap_buffer<std::pair<std::uint32_t, long>> done_;
+  std::vector<finished> ready_;
+  bool dispatching_ = false;
+  heap_buffer<int> files_;
+};
+}
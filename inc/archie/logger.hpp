@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <archie/container/spsc_queue.hpp>
+#include <archie/packed_args.hpp>
+#include <archie/per_thread.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+enum class overflow_policy { drop, block };
+
+namespace detail {
+  inline std::uint64_t steady_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  // Producers stamp records with the time stamp counter; the writer converts
+  // ticks to steady_clock nanoseconds, recalibrating before every drain.
+  struct log_clock {
+    static std::uint64_t now() { return __rdtsc(); }
+
+    void calibrate() {
+      auto const t = now();
+      auto const n = steady_ns();
+      if (t != ticks_) scale_ = static_cast<double>(n - ns_) / static_cast<double>(t - ticks_);
+    }
+    std::uint64_t to_ns(std::uint64_t t) const {
+      auto const delta = static_cast<double>(static_cast<std::int64_t>(t - ticks_)) * scale_;
+      return ns_ + static_cast<std::uint64_t>(static_cast<std::int64_t>(delta));
+    }
+
+  private:
+    std::uint64_t const ticks_ = now();
+    std::uint64_t const ns_ = steady_ns();
+    double scale_ = 1.0;
+  };
+#else
+  struct log_clock {
+    static std::uint64_t now() { return steady_ns(); }
+    void calibrate() {}
+    std::uint64_t to_ns(std::uint64_t t) const { return t; }
+  };
+#endif
+
+  template <typename... Args>
+  struct deferred_call {
+    using target = void (*)(std::string&, Args const&...);
+
+    static void invoke(std::string& out, void (*fn)(), unsigned char const* p) {
+      packed_args<Args...>::apply(
+          [&out, fn](Args const&... args) { reinterpret_cast<target>(fn)(out, args...); }, p);
+    }
+  };
+}
+
+template <std::size_t ArgBytes = 40>
+struct basic_logger {
+  using size_type = std::size_t;
+  using invoker = pure_function<void(std::string&, void (*)(), unsigned char const*)>;
+
+  struct record {
+    std::uint64_t timestamp;
+    invoker call;
+    void (*format)();
+    unsigned char args[ArgBytes];
+  };
+
+  explicit basic_logger(std::FILE* sink,
+                        size_type capacity = 4096,
+                        overflow_policy policy = overflow_policy::drop)
+      : sink_(sink),
+        capacity_(capacity),
+        policy_(policy),
+        writer_([this] { run(); }) {}
+  basic_logger(basic_logger const&) = delete;
+  basic_logger& operator=(basic_logger const&) = delete;
+  ~basic_logger() {
+    running_ = false;
+    writer_.join();
+  }
+
+  template <typename F, typename... Args>
+  bool log(F f, Args const&... args) {
+    static_assert(detail::packed_args<Args...>::size <= ArgBytes, "arguments do not fit a record");
+    static_assert(detail::all_trivially_copyable<Args...>::value,
+                  "arguments must be trivially copyable");
+    using call_t = detail::deferred_call<Args...>;
+
+    auto& q = local();
+    auto slot = q.claim();
+    while (slot == nullptr) {
+      if (policy_ == overflow_policy::drop) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      std::this_thread::yield();
+      slot = q.claim();
+    }
+    slot->timestamp = detail::log_clock::now();
+    slot->call = &call_t::invoke;
+    slot->format = reinterpret_cast<void (*)()>(static_cast<typename call_t::target>(
+        pure_function<void(std::string&, Args const&...)>(f)));
+    detail::packed_args<Args...>::store(slot->args, args...);
+    q.publish();
+    return true;
+  }
+
+  void flush() {
+    for (;;) {
+      if (queues_empty() && !busy_.load()) return;
+      std::this_thread::yield();
+    }
+  }
+
+  std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  size_type producers() const { return queues_.size(); }
+
+private:
+  using queue_type = spsc_queue<record>;
+
+  queue_type& local() { return queues_.local(capacity_); }
+
+  bool queues_empty() {
+    auto ret = true;
+    queues_.for_each([&ret](queue_type& q) { ret = ret && q.empty(); });
+    return ret;
+  }
+
+  size_type drain(std::string& buffer) {
+    snapshot_.clear();
+    queues_.for_each([this](queue_type& q) { snapshot_.push_back(&q); });
+    clock_.calibrate();
+    size_type n = 0;
+    for (auto q : snapshot_)
+      for (auto r = q->peek(); r != nullptr; r = q->peek()) {
+        buffer += std::to_string(clock_.to_ns(r->timestamp));
+        buffer += ' ';
+        r->call(buffer, r->format, r->args);
+        buffer += '\n';
+        q->pop();
+        ++n;
+      }
+    return n;
+  }
+
+  void run() {
+    std::string buffer;
+    for (;;) {
+      auto const stopping = !running_.load();
+      busy_ = true;
+      auto const n = drain(buffer);
+      if (!buffer.empty()) {
+        std::fwrite(buffer.data(), 1, buffer.size(), sink_);
+        std::fflush(sink_);
+        buffer.clear();
+      }
+      busy_ = false;
+      if (n == 0) {
+        if (stopping) return;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+  }
+
+  std::FILE* const sink_;
+  size_type const capacity_;
+  overflow_policy const policy_;
+  detail::per_thread<queue_type> queues_;
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> running_{true};
+  std::atomic<bool> busy_{false};
+  detail::log_clock clock_;
+  std::vector<queue_type*> snapshot_;
+  std::thread writer_;
+};
+
+using logger = basic_logger<>;
+}
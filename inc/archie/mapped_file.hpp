@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <archie/posix.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+enum class access { normal, sequential, random, willneed, dontneed };
+
+namespace detail {
+  inline int advice_of(access a) {
+    switch (a) {
+      case access::sequential:
+        return MADV_SEQUENTIAL;
+      case access::random:
+        return MADV_RANDOM;
+      case access::willneed:
+        return MADV_WILLNEED;
+      case access::dontneed:
+        return MADV_DONTNEED;
+      default:
+        return MADV_NORMAL;
+    }
+  }
+}
+
+template <typename T>
+struct mapped_view {
+  static_assert(std::is_trivially_copyable<T>::value, "mapped records must be trivially copyable");
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_pointer = T const*;
+  using const_reference = T const&;
+  using const_iterator = const_pointer;
+  using iterator = const_iterator;
+
+  mapped_view(const_pointer p, size_type n) : data_(p), size_(n) {}
+
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+  const_pointer data() const { return data_; }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+
+private:
+  const_pointer data_;
+  size_type size_;
+};
+
+struct mapped_file {
+  using size_type = std::size_t;
+
+  explicit mapped_file(std::string const& path)
+      : fd_(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+    if (!fd_) detail::throw_errno();
+    struct stat st;
+    if (::fstat(*fd_, &st) != 0) detail::throw_errno();
+    size_ = static_cast<size_type>(st.st_size);
+    if (size_ == 0) return;
+    auto const p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, *fd_, 0);
+    if (p == MAP_FAILED) detail::throw_errno();
+    map_ = detail::mapping_handle(p, detail::unmap_{size_});
+  }
+
+  void advise(access a) const { advise(a, 0, size_); }
+  void advise(access a, size_type offset, size_type length) const {
+    if (!map_ || length == 0) return;
+    auto const page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    auto const first = offset / page * page;
+    auto const base = static_cast<char*>(*map_) + first;
+    if (::madvise(base, offset + length - first, detail::advice_of(a)) != 0)
+      detail::throw_errno();
+  }
+
+  template <typename T>
+  mapped_view<T> as() const {
+    return mapped_view<T>(static_cast<T const*>(*map_), size_ / sizeof(T));
+  }
+
+  unsigned char const* data() const { return static_cast<unsigned char const*>(*map_); }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  detail::fd_handle fd_;
+  detail::mapping_handle map_;
+  size_type size_ = 0;
+};
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <archie/cache_line.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+namespace detail {
+  struct memo_hash {
+    template <typename... T>
+    std::size_t operator()(T const&... t) const {
+      using expand = int[];
+      std::size_t seed = 0;
+      static_cast<void>(expand{
+          0, (seed ^= std::hash<T>{}(t) + 0x9e3779b9u + (seed << 6) + (seed >> 2), 0)...});
+      return seed;
+    }
+  };
+
+  struct memo_stripe {
+    void lock() {
+      while (locked.exchange(true, std::memory_order_acquire))
+        while (locked.load(std::memory_order_relaxed)) std::this_thread::yield();
+    }
+    void unlock() { locked.store(false, std::memory_order_release); }
+
+    std::atomic<bool> locked{false};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+  };
+}
+
+template <typename F, std::size_t Capacity, typename Hash = detail::memo_hash,
+          std::size_t Stripes = 16>
+struct memoized;
+
+template <typename R, typename... Args, std::size_t Capacity, typename Hash, std::size_t Stripes>
+struct memoized<pure_function<R(Args...)>, Capacity, Hash, Stripes> {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of two");
+  static_assert(Stripes > 0, "");
+
+  using function_type = pure_function<R(Args...)>;
+  using result_type = R;
+  using size_type = std::size_t;
+
+private:
+  using key_type = std::tuple<std::decay_t<Args>...>;
+
+  struct entry {
+    key_type key;
+    R value;
+    bool used = false;
+  };
+  struct set {
+    entry way[2];
+    unsigned recent = 0;
+  };
+
+  static constexpr size_type sets = Capacity / 2;
+
+public:
+  explicit memoized(function_type f, Hash h = Hash{}) : fn_(f), hash_(h), sets_(sets) {
+    for (size_type idx = 0; idx < sets; ++idx) sets_.emplace_back();
+  }
+  memoized(memoized const&) = delete;
+  memoized& operator=(memoized const&) = delete;
+
+  template <typename... U>
+  R operator()(U const&... args) {
+    auto key = key_type(args...);
+    auto const idx = hash(key, std::index_sequence_for<Args...>{}) & (sets - 1);
+    auto& s = sets_[idx];
+    auto& stripe = stripes_[idx % Stripes].value;
+    {
+      std::lock_guard<detail::memo_stripe> lock(stripe);
+      if (auto const w = find(s, key)) {
+        s.recent = static_cast<unsigned>(w - s.way);
+        stripe.hits.fetch_add(1, std::memory_order_relaxed);
+        return w->value;
+      }
+      stripe.misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto ret = fn_(args...);
+    std::lock_guard<detail::memo_stripe> lock(stripe);
+    if (find(s, key) == nullptr) {
+      auto const victim = !s.way[0].used ? 0u : !s.way[1].used ? 1u : 1u - s.recent;
+      auto& e = s.way[victim];
+      e.key = std::move(key);
+      e.value = ret;
+      e.used = true;
+      s.recent = victim;
+    }
+    return ret;
+  }
+
+  void clear() {
+    for (size_type idx = 0; idx < sets; ++idx) {
+      auto& stripe = stripes_[idx % Stripes].value;
+      std::lock_guard<detail::memo_stripe> lock(stripe);
+      sets_[idx].way[0].used = sets_[idx].way[1].used = false;
+    }
+  }
+
+  std::uint64_t hits() const { return sum(&detail::memo_stripe::hits); }
+  std::uint64_t misses() const { return sum(&detail::memo_stripe::misses); }
+  size_type capacity() const { return Capacity; }
+  function_type function() const { return fn_; }
+
+private:
+  template <std::size_t... I>
+  size_type hash(key_type const& key, std::index_sequence<I...>) const {
+    return hash_(std::get<I>(key)...);
+  }
+
+  static entry* find(set& s, key_type const& key) {
+    for (auto& e : s.way)
+      if (e.used && e.key == key) return &e;
+    return nullptr;
+  }
+
+  std::uint64_t sum(std::atomic<std::uint64_t> detail::memo_stripe::*counter) const {
+    std::uint64_t ret = 0;
+    for (auto const& s : stripes_) ret += (s.value.*counter).load(std::memory_order_relaxed);
+    return ret;
+  }
+
+  function_type const fn_;
+  Hash const hash_;
+  heap_buffer<set> sets_;
+  cache_padded<detail::memo_stripe> stripes_[Stripes];
+};
+
+template <typename R, typename... Args, std::size_t Capacity, typename Hash, std::size_t Stripes>
+constexpr std::size_t memoized<pure_function<R(Args...)>, Capacity, Hash, Stripes>::sets;
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/mpmc_queue.hpp>
+#include <archie/inplace_function.hpp>
+#include <archie/per_thread.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+struct pool_stats {
+  std::uint64_t checkouts;
+  std::uint64_t cache_hits;
+  std::uint64_t shared_hits;
+  std::uint64_t exhausted;
+  std::uint64_t returns;
+};
+
+namespace detail {
+  struct no_reset {
+    template <typename T>
+    void operator()(T&) const {}
+  };
+
+  template <typename T>
+  struct pool_slot {
+    T* get() { return reinterpret_cast<T*>(&storage); }
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    bool live = false;
+  };
+}
+
+template <typename T, typename Reset = detail::no_reset>
+struct object_pool {
+  using value_type = T;
+  using size_type = std::size_t;
+  using factory = inplace_function<void(void*), 64>;
+
+  struct return_to_pool {
+    void operator()(T* p) const {
+      if (p != nullptr) pool->give_back(p);
+    }
+    object_pool* pool;
+  };
+  using handle = resource<T*, return_to_pool>;
+
+private:
+  struct local_cache {
+    explicit local_cache(size_type n) : objects(n) {}
+    heap_buffer<T*> objects;
+    std::atomic<std::uint64_t> checkouts{0};
+    std::atomic<std::uint64_t> cache_hits{0};
+    std::atomic<std::uint64_t> shared_hits{0};
+    std::atomic<std::uint64_t> exhausted{0};
+    std::atomic<std::uint64_t> returns{0};
+  };
+
+public:
+  explicit object_pool(size_type capacity,
+                       size_type cache = 8,
+                       factory make = factory(&construct_default),
+                       Reset reset = Reset{})
+      : slots_(capacity),
+        shared_(capacity),
+        raw_(capacity),
+        cache_(cache > 0 ? cache : 1),
+        make_(std::move(make)),
+        reset_(std::move(reset)),
+        caches_(&flush, this) {
+    for (size_type idx = 0; idx < capacity; ++idx) slots_.emplace_back();
+  }
+  object_pool(object_pool const&) = delete;
+  object_pool& operator=(object_pool const&) = delete;
+  ~object_pool() {
+    auto const n = claimed_.load(std::memory_order_acquire);
+    for (size_type idx = 0; idx < n; ++idx)
+      if (slots_[idx].live) slots_[idx].get()->~T();
+  }
+
+  handle checkout() { return handle(acquire(), return_to_pool{this}); }
+
+  size_type capacity() const { return slots_.size(); }
+  size_type created() const { return created_.load(std::memory_order_relaxed); }
+
+  pool_stats stats() const {
+    pool_stats ret{0, 0, 0, 0, 0};
+    caches_.for_each([&ret](local_cache const& c) {
+      ret.checkouts += c.checkouts.load(std::memory_order_relaxed);
+      ret.cache_hits += c.cache_hits.load(std::memory_order_relaxed);
+      ret.shared_hits += c.shared_hits.load(std::memory_order_relaxed);
+      ret.exhausted += c.exhausted.load(std::memory_order_relaxed);
+      ret.returns += c.returns.load(std::memory_order_relaxed);
+    });
+    return ret;
+  }
+
+private:
+  static void construct_default(void* p) { new (p) T(); }
+
+  static void bump(std::atomic<std::uint64_t>& c) {
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  local_cache& local() { return caches_.local(cache_); }
+
+  static void flush(void* self, local_cache& c) {
+    auto& pool = *static_cast<object_pool*>(self);
+    while (!c.objects.empty()) pool.shared_.try_push(pop(c));
+  }
+
+  T* acquire() {
+    auto& c = local();
+    bump(c.checkouts);
+    if (!c.objects.empty()) {
+      bump(c.cache_hits);
+      return pop(c);
+    }
+    if (refill(c)) return pop(c);
+    if (auto const p = create()) return p;
+    if (refill(c)) return pop(c);
+    bump(c.exhausted);
+    return nullptr;
+  }
+
+  T* create() {
+    size_type idx = 0;
+    if (!raw_.try_pop(idx) && !claim(idx)) return nullptr;
+    auto& s = slots_[idx];
+    try {
+      make_(s.get());
+    } catch (...) {
+      raw_.try_push(idx);
+      throw;
+    }
+    s.live = true;
+    created_.fetch_add(1, std::memory_order_acq_rel);
+    return s.get();
+  }
+
+  bool claim(size_type& idx) {
+    auto n = claimed_.load(std::memory_order_relaxed);
+    while (n < slots_.size())
+      if (claimed_.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel)) {
+        idx = n;
+        return true;
+      }
+    return false;
+  }
+
+  static T* pop(local_cache& c) {
+    auto const p = c.objects[c.objects.size() - 1];
+    c.objects.pop_back();
+    return p;
+  }
+
+  bool refill(local_cache& c) {
+    T* p = nullptr;
+    while (c.objects.size() < (cache_ + 1) / 2 && shared_.try_pop(p)) c.objects.emplace_back(p);
+    if (c.objects.empty()) return false;
+    bump(c.shared_hits);
+    return true;
+  }
+
+  void give_back(T* p) {
+    reset_(*p);
+    auto& c = local();
+    bump(c.returns);
+    if (c.objects.size() == cache_)
+      while (c.objects.size() > cache_ / 2) shared_.try_push(pop(c));
+    c.objects.emplace_back(p);
+  }
+
+  heap_buffer<detail::pool_slot<T>> slots_;
+  mpmc_queue<T*> shared_;
+  mpmc_queue<size_type> raw_;
+  size_type const cache_;
+  factory make_;
+  Reset reset_;
+  std::atomic<size_type> claimed_{0};
+  std::atomic<size_type> created_{0};
+  detail::per_thread<local_cache> caches_;
+};
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace archie {
+namespace detail {
+  template <typename... Args>
+  constexpr std::size_t arg_offset(std::size_t n) {
+    std::size_t const sizes[] = {0, sizeof(Args)...};
+    std::size_t ret = 0;
+    for (std::size_t idx = 0; idx < n; ++idx) ret += sizes[idx + 1];
+    return ret;
+  }
+
+  template <typename T>
+  T load_arg(unsigned char const* p) {
+    T ret;
+    std::memcpy(&ret, p, sizeof(T));
+    return ret;
+  }
+
+  template <typename... Args>
+  using all_trivially_copyable =
+      std::is_same<std::integer_sequence<bool, true, std::is_trivially_copyable<Args>::value...>,
+                   std::integer_sequence<bool, std::is_trivially_copyable<Args>::value..., true>>;
+
+  template <typename... Args>
+  struct packed_args {
+    static constexpr std::size_t size = arg_offset<Args...>(sizeof...(Args));
+
+    static void store(unsigned char* p, Args const&... args) {
+      using expand = int[];
+      std::size_t off = 0;
+      static_cast<void>(
+          expand{0, (std::memcpy(p + off, &args, sizeof(Args)), off += sizeof(Args), 0)...});
+    }
+
+    template <typename F>
+    static void apply(F&& f, unsigned char const* p) {
+      apply(std::forward<F>(f), p, std::index_sequence_for<Args...>{});
+    }
+
+  private:
+    template <typename F, std::size_t... I>
+    static void apply(F&& f, unsigned char const* p, std::index_sequence<I...>) {
+      static_cast<void>(p);
+      std::forward<F>(f)(load_arg<Args>(p + arg_offset<Args...>(I))...);
+    }
+  };
+
+  template <typename... Args>
+  constexpr std::size_t packed_args<Args...>::size;
+}
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/thread_pool.hpp>
+
+namespace archie {
+namespace par {
+  struct options {
+    std::size_t grain = 0;
+    std::size_t serial_below = 1 << 15;
+    thread_pool* pool = nullptr;
+  };
+
+  inline thread_pool& default_pool() {
+    static thread_pool pool;
+    return pool;
+  }
+
+  namespace detail {
+    template <typename F>
+    void run_chunks(std::size_t first, std::size_t last, F* const& f) {
+      for (; first != last; ++first) (*f)(first);
+    }
+
+    struct partition {
+      partition(options const& opts, std::size_t n)
+          : size(n),
+            grain(opts.grain != 0 ? opts.grain : std::max<std::size_t>(4096, n / 256)),
+            chunks((n + grain - 1) / grain),
+            serial(n < opts.serial_below) {}
+
+      std::size_t first(std::size_t chunk) const { return chunk * grain; }
+      std::size_t last(std::size_t chunk) const { return std::min(size, (chunk + 1) * grain); }
+
+      std::size_t const size;
+      std::size_t const grain;
+      std::size_t const chunks;
+      bool const serial;
+    };
+
+    template <typename F>
+    void for_chunks(options const& opts, partition const& p, F f) {
+      if (p.serial) {
+        for (std::size_t c = 0; c != p.chunks; ++c) f(c);
+        return;
+      }
+      auto& pool = opts.pool != nullptr ? *opts.pool : default_pool();
+      F* const ctx = &f;
+      pool.parallel_for(blocked_range{0, p.chunks, 1}, &run_chunks<F>, ctx);
+    }
+  }
+
+  template <typename Range, typename F>
+  void for_each(Range& r, F f, options const& opts = {}) {
+    auto const data = r.data();
+    detail::partition const p(opts, r.size());
+    detail::for_chunks(opts, p, [&](std::size_t c) {
+      for (auto idx = p.first(c); idx != p.last(c); ++idx) f(data[idx]);
+    });
+  }
+
+  template <typename Range, typename OutRange, typename F>
+  void transform(Range const& in, OutRange& out, F f, options const& opts = {}) {
+    auto const src = in.data();
+    auto const dst = out.data();
+    detail::partition const p(opts, std::min<std::size_t>(in.size(), out.size()));
+    detail::for_chunks(opts, p, [&](std::size_t c) {
+      for (auto idx = p.first(c); idx != p.last(c); ++idx) dst[idx] = f(src[idx]);
+    });
+  }
+
+  template <typename Range, typename T, typename BinaryOp>
+  T reduce(Range const& r, T init, BinaryOp op, options const& opts = {}) {
+    auto const data = r.data();
+    detail::partition const p(opts, r.size());
+    heap_buffer<T> partials(p.chunks);
+    for (std::size_t c = 0; c != p.chunks; ++c) partials.emplace_back(init);
+    detail::for_chunks(opts, p, [&](std::size_t c) {
+      auto idx = p.first(c);
+      T acc = data[idx];
+      for (++idx; idx != p.last(c); ++idx) acc = op(std::move(acc), data[idx]);
+      partials[c] = std::move(acc);
+    });
+    for (auto& x : partials) init = op(std::move(init), x);
+    return init;
+  }
+
+  template <typename Range, typename T>
+  T reduce(Range const& r, T init, options const& opts = {}) {
+    return par::reduce(r, std::move(init), [](T const& a, T const& b) { return a + b; }, opts);
+  }
+
+  template <typename Range, typename OutRange, typename BinaryOp>
+  void inclusive_scan(Range const& in, OutRange& out, BinaryOp op, options const& opts = {}) {
+    using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*in.data())>>;
+    auto const src = in.data();
+    auto const dst = out.data();
+    detail::partition const p(opts, std::min<std::size_t>(in.size(), out.size()));
+    if (p.chunks == 0) return;
+    heap_buffer<value_type> carry(p.chunks);
+    for (std::size_t c = 0; c != p.chunks; ++c) carry.emplace_back(src[p.first(c)]);
+    detail::for_chunks(opts, p, [&](std::size_t c) {
+      for (auto idx = p.first(c) + 1; idx != p.last(c); ++idx)
+        carry[c] = op(std::move(carry[c]), src[idx]);
+    });
+    for (std::size_t c = 1; c != p.chunks; ++c) carry[c] = op(carry[c - 1], carry[c]);
+    detail::for_chunks(opts, p, [&](std::size_t c) {
+      auto idx = p.first(c);
+      value_type acc = c == 0 ? src[idx] : op(carry[c - 1], src[idx]);
+      dst[idx] = acc;
+      for (++idx; idx != p.last(c); ++idx) dst[idx] = acc = op(std::move(acc), src[idx]);
+    });
+  }
+
+  template <typename Range, typename OutRange>
+  void inclusive_scan(Range const& in, OutRange& out, options const& opts = {}) {
+    using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*in.data())>>;
+    par::inclusive_scan(
+        in, out, [](value_type const& a, value_type const& b) { return a + b; }, opts);
+  }
+
+  template <typename Range, typename Compare>
+  void sort(Range& r, Compare comp, options const& opts = {}) {
+    auto const data = r.data();
+    detail::partition const p(opts, r.size());
+    detail::for_chunks(
+        opts, p, [&](std::size_t c) { std::sort(data + p.first(c), data + p.last(c), comp); });
+    for (std::size_t width = 1; width < p.chunks; width *= 2) {
+      auto const n = (p.chunks + 2 * width - 1) / (2 * width);
+      options merge_opts = opts;
+      merge_opts.grain = 1;
+      merge_opts.serial_below = p.serial ? n + 1 : 0;
+      detail::partition const pairs(merge_opts, n);
+      detail::for_chunks(merge_opts, pairs, [&](std::size_t m) {
+        auto const first = p.first(2 * m * width);
+        auto const mid = std::min(p.size, p.first((2 * m + 1) * width));
+        auto const last = std::min(p.size, p.first((2 * m + 2) * width));
+        std::inplace_merge(data + first, data + mid, data + last, comp);
+      });
+    }
+  }
+
+  template <typename Range>
+  void sort(Range& r, options const& opts = {}) {
+    using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*r.data())>>;
+    par::sort(r, [](value_type const& a, value_type const& b) { return a < b; }, opts);
+  }
+}
+}
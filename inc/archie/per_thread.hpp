@@ -0,0 +1,138 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace archie {
+namespace detail {
+  struct per_thread_state {
+    std::mutex mtx;
+    std::atomic<bool> alive{true};
+    void* owner = nullptr;
+    void (*release)(void*, void*) = nullptr;
+  };
+
+  struct per_thread_hooks {
+    struct hook {
+      std::uint64_t id;
+      void* slot;
+      std::shared_ptr<per_thread_state> state;
+    };
+
+    ~per_thread_hooks() {
+      for (auto const& h : hooks) {
+        std::lock_guard<std::mutex> lock(h.state->mtx);
+        if (h.state->alive.load(std::memory_order_relaxed)) h.state->release(h.state->owner, h.slot);
+      }
+    }
+
+    void* find(std::uint64_t id) const {
+      for (auto const& h : hooks)
+        if (h.id == id) return h.slot;
+      return nullptr;
+    }
+
+    void prune() {
+      auto out = hooks.begin();
+      for (auto& h : hooks)
+        if (h.state->alive.load(std::memory_order_relaxed)) *out++ = std::move(h);
+      hooks.erase(out, hooks.end());
+    }
+
+    std::vector<hook> hooks;
+  };
+
+  inline per_thread_hooks& thread_hooks() {
+    static thread_local per_thread_hooks hooks;
+    return hooks;
+  }
+
+  inline std::uint64_t next_per_thread_id() {
+    static std::atomic<std::uint64_t> id(0);
+    return ++id;
+  }
+
+  template <typename Slot>
+  struct per_thread {
+    using exit_hook = void (*)(void*, Slot&);
+
+    explicit per_thread(exit_hook on_exit = nullptr, void* context = nullptr)
+        : state_(std::make_shared<per_thread_state>()),
+          id_(next_per_thread_id()),
+          on_exit_(on_exit),
+          context_(context) {
+      state_->owner = this;
+      state_->release = &release;
+    }
+    per_thread(per_thread const&) = delete;
+    per_thread& operator=(per_thread const&) = delete;
+    ~per_thread() {
+      std::lock_guard<std::mutex> lock(state_->mtx);
+      state_->alive = false;
+    }
+
+    template <typename... Args>
+    Slot& local(Args&&... args) {
+      auto& hooks = thread_hooks();
+      if (auto const p = hooks.find(id_)) return *static_cast<Slot*>(p);
+      return attach(hooks, std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+      std::lock_guard<std::mutex> lock(state_->mtx);
+      for (auto const& n : slots_) f(*n.slot);
+    }
+
+    std::size_t size() const {
+      std::lock_guard<std::mutex> lock(state_->mtx);
+      return slots_.size();
+    }
+
+    std::mutex& mutex() const { return state_->mtx; }
+
+  private:
+    struct node {
+      std::unique_ptr<Slot> slot;
+      bool active;
+    };
+
+    static void release(void* owner, void* slot) {
+      auto const self = static_cast<per_thread*>(owner);
+      auto const s = static_cast<Slot*>(slot);
+      if (self->on_exit_ != nullptr) self->on_exit_(self->context_, *s);
+      for (auto& n : self->slots_)
+        if (n.slot.get() == s) n.active = false;
+    }
+
+    template <typename... Args>
+    Slot& attach(per_thread_hooks& hooks, Args&&... args) {
+      std::lock_guard<std::mutex> lock(state_->mtx);
+      Slot* found = nullptr;
+      for (auto& n : slots_)
+        if (!n.active) {
+          n.active = true;
+          found = n.slot.get();
+          break;
+        }
+      if (found == nullptr) {
+        slots_.push_back(node{std::unique_ptr<Slot>(new Slot(std::forward<Args>(args)...)), true});
+        found = slots_.back().slot.get();
+      }
+      hooks.prune();
+      hooks.hooks.push_back(per_thread_hooks::hook{id_, found, state_});
+      return *found;
+    }
+
+    std::shared_ptr<per_thread_state> const state_;
+    std::uint64_t const id_;
+    exit_hook const on_exit_;
+    void* const context_;
+    std::vector<node> slots_;
+  };
+}
+}
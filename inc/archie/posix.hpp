@@ -0,0 +1,27 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <archie/resource.hpp>
+
+namespace archie {
+namespace detail {
+  struct close_fd_ {
+    void operator()(int fd) const {
+      if (fd >= 0) ::close(fd);
+    }
+  };
+
+  struct unmap_ {
+    void operator()(void* p) const { ::munmap(p, size); }
+    std::size_t size = 0;
+  };
+
+  using fd_handle = reserved_resource<int, close_fd_, -1>;
+  using mapping_handle = reserved_resource<void*, unmap_, nullptr>;
+
+  inline void throw_errno() { throw std::system_error(errno, std::system_category()); }
+}
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <archie/container/mpmc_queue.hpp>
+#include <archie/inplace_function.hpp>
+#include <archie/resource.hpp>
+
+namespace archie {
+template <std::size_t Capacity = 48>
+struct basic_reclaimer {
+  using size_type = std::size_t;
+  using task =
+      inplace_function<void(), Capacity, alignof(std::max_align_t), function_policy::move_only>;
+
+  template <typename F>
+  using fits = std::integral_constant<bool,
+                                      sizeof(F) <= Capacity &&
+                                          alignof(std::max_align_t) % alignof(F) == 0>;
+
+  explicit basic_reclaimer(size_type capacity = 1024)
+      : tasks_(capacity), worker_([this] { run(); }) {}
+  basic_reclaimer(basic_reclaimer const&) = delete;
+  basic_reclaimer& operator=(basic_reclaimer const&) = delete;
+  ~basic_reclaimer() {
+    running_ = false;
+    worker_.join();
+  }
+
+  template <typename F>
+  bool post(F&& f) {
+    return post(std::forward<F>(f), fits<std::decay_t<F>>{});
+  }
+
+  void flush() {
+    auto const target = posted_.load(std::memory_order_acquire);
+    while (reclaimed_.load(std::memory_order_acquire) < target)
+      if (!run_one()) std::this_thread::yield();
+  }
+
+  size_type pending() const { return tasks_.size(); }
+  size_type capacity() const { return tasks_.capacity(); }
+  std::uint64_t posted() const { return posted_.load(std::memory_order_relaxed); }
+  std::uint64_t reclaimed() const { return reclaimed_.load(std::memory_order_relaxed); }
+  std::uint64_t inline_runs() const { return inline_.load(std::memory_order_relaxed); }
+
+private:
+  template <typename F>
+  bool post(F&& f, std::true_type) {
+    if (tasks_.try_emplace(std::forward<F>(f))) {
+      posted_.fetch_add(1, std::memory_order_release);
+      return true;
+    }
+    return post(std::forward<F>(f), std::false_type{});
+  }
+  template <typename F>
+  bool post(F&& f, std::false_type) {
+    inline_.fetch_add(1, std::memory_order_relaxed);
+    f();
+    return false;
+  }
+
+  bool run_one() {
+    task t;
+    if (!tasks_.try_pop(t)) return false;
+    t();
+    reclaimed_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+
+  void run() {
+    for (;;) {
+      auto const stopping = !running_.load();
+      if (run_one()) continue;
+      if (stopping) return;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  mpmc_queue<task> tasks_;
+  std::atomic<std::uint64_t> posted_{0};
+  std::atomic<std::uint64_t> reclaimed_{0};
+  std::atomic<std::uint64_t> inline_{0};
+  std::atomic<bool> running_{true};
+  std::thread worker_;
+};
+
+using reclaimer = basic_reclaimer<>;
+
+template <std::size_t Capacity = 48>
+basic_reclaimer<Capacity>& default_reclaimer() {
+  static basic_reclaimer<Capacity> r;
+  return r;
+}
+
+template <typename Deleter, std::size_t Capacity = 48>
+struct deferred_deleter : private detail::deleter_storage<Deleter> {
+private:
+  using base_t = detail::deleter_storage<Deleter>;
+
+public:
+  using reclaimer_type = basic_reclaimer<Capacity>;
+
+  deferred_deleter() : r_(&default_reclaimer<Capacity>()) {}
+  explicit deferred_deleter(reclaimer_type& r, Deleter del = Deleter{})
+      : base_t(std::move(del)), r_(&r) {}
+
+  template <typename T>
+  void operator()(T&& t) {
+    using call_t = detail::deferred_call_<Deleter, std::decay_t<T>>;
+    r_->post(call_t{this->deleter(), std::move(t)});
+  }
+
+private:
+  reclaimer_type* r_;
+};
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <utility>
+#include <type_traits>
 #include <experimental/optional>
+#include <archie/inapt.hpp>
 #include <archie/meta/static_constexpr_storage.hpp>
 
 namespace archie {
@@ -31,8 +33,18 @@ struct resource {
 
   resource(resource const&) = delete;
   resource& operator=(resource const&) = delete;
-  resource(resource&&) = default;
-  resource& operator=(resource&&) = default;
+  resource(resource&& other) : r(std::move(other.r)), d(std::move(other.d)) {
+    other.d = std::experimental::nullopt;
+  }
+  resource& operator=(resource&& other) {
+    if (this != &other) {
+      if (d) (*d)(r);
+      r = std::move(other.r);
+      d = std::move(other.d);
+      other.d = std::experimental::nullopt;
+    }
+    return *this;
+  }
   ~resource() {
     if (d) (*d)(r);
   }
@@ -62,6 +74,90 @@ private:
   deleter_type d;
 };
 
+namespace detail {
+  template <typename D, bool = std::is_empty<D>::value && !std::is_final<D>::value>
+  struct deleter_storage : private D {
+    deleter_storage() = default;
+    explicit deleter_storage(D del) : D(std::move(del)) {}
+    D& deleter() { return *this; }
+  };
+
+  template <typename D>
+  struct deleter_storage<D, false> {
+    deleter_storage() = default;
+    explicit deleter_storage(D del) : d(std::move(del)) {}
+    D& deleter() { return d; }
+
+  private:
+    D d;
+  };
+
+  template <typename Deleter, typename T>
+  struct deferred_call_ {
+    void operator()() { deleter(value); }
+    Deleter deleter;
+    T value;
+  };
+}
+
+template <typename T, typename Deleter, typename Policy>
+struct compact_resource : private detail::deleter_storage<Deleter> {
+private:
+  using base_t = detail::deleter_storage<Deleter>;
+  using handle_type = inapt_t<T, Policy>;
+
+public:
+  using deleter_type = Deleter;
+  using value_type = T;
+  using pointer = T const*;
+  using const_reference = T const&;
+
+  compact_resource() = default;
+  explicit compact_resource(T t, Deleter del = Deleter{}) : base_t(std::move(del)), h(t) {}
+
+  compact_resource(compact_resource const&) = delete;
+  compact_resource& operator=(compact_resource const&) = delete;
+  compact_resource(compact_resource&& other) : base_t(std::move(other)), h(other.h) {
+    other.h = null_inapt_t{};
+  }
+  compact_resource& operator=(compact_resource&& other) {
+    if (this != &other) {
+      reset();
+      base_t::operator=(std::move(other));
+      h = other.h;
+      other.h = null_inapt_t{};
+    }
+    return *this;
+  }
+  ~compact_resource() { reset(); }
+
+  const_reference operator*() const { return h.get(); }
+  pointer operator->() const { return &h.get(); }
+  explicit operator bool() const { return !h.is_null(); }
+
+  compact_resource& operator=(null_resource_t const&) {
+    reset();
+    return *this;
+  }
+
+  void reset() {
+    if (!h.is_null()) this->deleter()(h.get());
+    h = null_inapt_t{};
+  }
+
+  value_type release() {
+    auto const ret = h.get();
+    h = null_inapt_t{};
+    return ret;
+  }
+
+private:
+  handle_type h;
+};
+
+template <typename T, typename Deleter, T... Null>
+using reserved_resource = compact_resource<T, Deleter, detail::reserved_value_t<T, Null...>>;
+
 namespace detail {
   struct make_resource_ {
     template <typename T, typename D>
@@ -0,0 +1,295 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/mpmc_queue.hpp>
+#include <archie/container/stack_buffer.hpp>
+#include <archie/container/work_stealing_deque.hpp>
+#include <archie/packed_args.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+struct wait_group {
+  explicit wait_group(std::size_t n = 0) : pending_(n) {}
+  wait_group(wait_group const&) = delete;
+  wait_group& operator=(wait_group const&) = delete;
+
+  void add(std::size_t n = 1) { pending_.fetch_add(n, std::memory_order_relaxed); }
+  void done() { pending_.fetch_sub(1, std::memory_order_release); }
+  std::size_t pending() const { return pending_.load(std::memory_order_acquire); }
+
+private:
+  std::atomic<std::size_t> pending_;
+};
+
+struct blocked_range {
+  std::size_t first;
+  std::size_t last;
+  std::size_t grain;
+};
+
+struct worker_stats {
+  std::uint64_t executed;
+  std::uint64_t steals;
+  std::uint64_t idle;
+};
+
+template <std::size_t ArgBytes = 48>
+struct basic_thread_pool {
+  using size_type = std::size_t;
+
+private:
+  struct task;
+  using invoker = pure_function<void(basic_thread_pool&, task const&)>;
+
+  struct task {
+    invoker call;
+    void (*fn)() = nullptr;
+    wait_group* group = nullptr;
+    stack_buffer<unsigned char, ArgBytes> args;
+  };
+
+  struct worker {
+    explicit worker(size_type n) : tasks(n) {}
+    work_stealing_deque<task> tasks;
+    std::atomic<std::uint64_t> executed{0};
+    std::atomic<std::uint64_t> steals{0};
+    std::atomic<std::uint64_t> idle{0};
+  };
+
+  template <typename... Args>
+  struct call_ {
+    using target = void (*)(Args const&...);
+    static void invoke(basic_thread_pool&, task const& t) {
+      detail::packed_args<Args...>::apply(
+          [&t](Args const&... args) { reinterpret_cast<target>(t.fn)(args...); },
+          t.args.data());
+    }
+  };
+
+  template <typename... Args>
+  struct range_ {
+    using target = void (*)(size_type, size_type, Args const&...);
+    static void invoke(basic_thread_pool& pool, task const& t) {
+      detail::packed_args<size_type, size_type, size_type, Args...>::apply(
+          [&pool, &t](size_type first, size_type last, size_type grain, Args const&... args) {
+            pool.run_range(t, first, last, grain, args...);
+          },
+          t.args.data());
+    }
+  };
+
+public:
+  explicit basic_thread_pool(size_type threads = std::thread::hardware_concurrency(),
+                             size_type deque_capacity = 1024)
+      : workers_(threads > 0 ? threads : 1),
+        threads_(workers_.capacity()),
+        injected_(deque_capacity) {
+    for (size_type idx = 0; idx < workers_.capacity(); ++idx)
+      workers_.emplace_back(deque_capacity);
+    for (size_type idx = 0; idx < workers_.capacity(); ++idx)
+      threads_.emplace_back([this, idx] { run(idx); });
+  }
+  basic_thread_pool(basic_thread_pool const&) = delete;
+  basic_thread_pool& operator=(basic_thread_pool const&) = delete;
+  ~basic_thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) t.join();
+  }
+
+  template <typename F, typename... Args>
+  void submit(F f, Args const&... args) {
+    enqueue(nullptr, &call_<Args...>::invoke, to_pointer<void(Args const&...)>(f), args...);
+  }
+
+  template <typename F, typename... Args>
+  void submit(wait_group& wg, F f, Args const&... args) {
+    wg.add();
+    enqueue(&wg, &call_<Args...>::invoke, to_pointer<void(Args const&...)>(f), args...);
+  }
+
+  void wait(wait_group const& wg) {
+    while (wg.pending() != 0)
+      if (!run_one()) std::this_thread::yield();
+  }
+
+  template <typename F, typename... Args>
+  void parallel_for(size_type first, size_type last, F f, Args const&... args) {
+    auto const grain = first < last ? (last - first) / (workers_.size() * 8) : 0;
+    parallel_for(blocked_range{first, last, grain}, f, args...);
+  }
+
+  template <typename F, typename... Args>
+  void parallel_for(blocked_range r, F f, Args const&... args) {
+    if (r.first >= r.last) return;
+    wait_group wg;
+    wg.add();
+    enqueue(&wg,
+            &range_<Args...>::invoke,
+            to_pointer<void(size_type, size_type, Args const&...)>(f),
+            r.first,
+            r.last,
+            std::max<size_type>(1, r.grain),
+            args...);
+    wait(wg);
+  }
+
+  size_type size() const { return workers_.size(); }
+  worker_stats stats(size_type idx) const {
+    auto const& w = workers_[idx];
+    return worker_stats{w.executed.load(std::memory_order_relaxed),
+                        w.steals.load(std::memory_order_relaxed),
+                        w.idle.load(std::memory_order_relaxed)};
+  }
+
+private:
+  template <typename Sig, typename F>
+  static void (*to_pointer(F f))() {
+    return reinterpret_cast<void (*)()>(static_cast<typename pure_function<Sig>::pointer>(
+        pure_function<Sig>(f)));
+  }
+
+  struct worker_tag {
+    basic_thread_pool const* pool;
+    worker* self;
+  };
+
+  static worker_tag& current() {
+    static thread_local worker_tag tag{nullptr, nullptr};
+    return tag;
+  }
+  worker* local() {
+    auto const& tag = current();
+    return tag.pool == this ? tag.self : nullptr;
+  }
+
+  template <typename... Args>
+  void enqueue(wait_group* wg, void (*call)(basic_thread_pool&, task const&), void (*fn)(),
+               Args const&... args) {
+    static_assert(detail::packed_args<Args...>::size <= ArgBytes, "arguments do not fit a task");
+    static_assert(detail::all_trivially_copyable<Args...>::value,
+                  "arguments must be trivially copyable");
+    task t;
+    t.call = call;
+    t.fn = fn;
+    t.group = wg;
+    for (size_type idx = 0; idx < detail::packed_args<Args...>::size; ++idx)
+      t.args.emplace_back(static_cast<unsigned char>(0));
+    detail::packed_args<Args...>::store(t.args.data(), args...);
+
+    auto const w = local();
+    if (w != nullptr ? w->tasks.push(t) : injected_.try_push(t)) {
+      if (sleepers_.load(std::memory_order_seq_cst) != 0) cv_.notify_one();
+      return;
+    }
+    execute(t);
+  }
+
+  template <typename... Args>
+  void run_range(task const& t, size_type first, size_type last, size_type grain,
+                 Args const&... args) {
+    using target = typename range_<Args...>::target;
+    while (first < last) {
+      if (last - first > grain && local_idle()) {
+        auto const mid = first + (last - first) / 2;
+        t.group->add();
+        enqueue(t.group, t.call, t.fn, mid, last, grain, args...);
+        last = mid;
+        continue;
+      }
+      auto const end = first + std::min(grain, last - first);
+      reinterpret_cast<target>(t.fn)(first, end, args...);
+      first = end;
+    }
+  }
+
+  bool local_idle() {
+    auto const w = local();
+    return w != nullptr ? w->tasks.empty() : injected_.empty();
+  }
+
+  void execute(task const& t) {
+    t.call(*this, t);
+    if (t.group != nullptr) t.group->done();
+  }
+
+  bool run_one() {
+    task t;
+    auto const w = local();
+    if (w != nullptr && w->tasks.pop(t)) {
+      execute(t);
+      w->executed.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    if (injected_.try_pop(t) || steal(w, t)) {
+      execute(t);
+      if (w != nullptr) w->executed.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  bool steal(worker* self, task& t) {
+    auto const n = workers_.size();
+    auto const first = self != nullptr ? static_cast<size_type>(self - workers_.data()) + 1 : 0;
+    for (size_type idx = 0; idx < n; ++idx) {
+      auto& victim = workers_[(first + idx) % n];
+      if (&victim == self) continue;
+      if (victim.tasks.steal(t)) {
+        if (self != nullptr) self->steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool has_work() const {
+    if (!injected_.empty()) return true;
+    for (auto const& w : workers_)
+      if (!w.tasks.empty()) return true;
+    return false;
+  }
+
+  void run(size_type idx) {
+    auto& self = workers_[idx];
+    current() = worker_tag{this, &self};
+    for (unsigned spins = 0;;) {
+      if (run_one()) {
+        spins = 0;
+        continue;
+      }
+      if (++spins < 64) {
+        std::this_thread::yield();
+        continue;
+      }
+      spins = 0;
+      self.idle.fetch_add(1, std::memory_order_relaxed);
+      std::unique_lock<std::mutex> lock(mtx_);
+      if (stopping_ && !has_work()) return;
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      if (!has_work()) cv_.wait_for(lock, std::chrono::milliseconds(1));
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  heap_buffer<worker> workers_;
+  heap_buffer<std::thread> threads_;
+  mpmc_queue<task> injected_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::atomic<size_type> sleepers_{0};
+  bool stopping_ = false;
+};
+
+using thread_pool = basic_thread_pool<>;
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/ring_iterator.hpp>
+#include <archie/inapt.hpp>
+#include <archie/pure_function.hpp>
+
+namespace archie {
+template <std::size_t Levels = 4, std::size_t Bits = 6>
+struct timer_wheel {
+  static_assert(Levels > 0 && Bits > 0 && Levels * Bits < 64, "");
+
+  using size_type = std::size_t;
+  using tick_type = std::uint64_t;
+  using callback = pure_function<void(std::uint64_t)>;
+  using timer_id = reserved_t<std::uint64_t, ~std::uint64_t(0)>;
+
+private:
+  static constexpr std::uint32_t npos = ~std::uint32_t(0);
+  static constexpr size_type slots = size_type(1) << Bits;
+  static constexpr tick_type mask = slots - 1;
+  static constexpr tick_type range = tick_type(1) << (Levels * Bits);
+  static constexpr std::uint32_t firing = Levels * slots;
+
+  struct node {
+    tick_type deadline = 0;
+    callback cb;
+    std::uint64_t arg = 0;
+    std::uint32_t prev = npos;
+    std::uint32_t next = npos;
+    std::uint32_t bucket = npos;
+    std::uint32_t generation = 0;
+  };
+  using cursor_type = ring_iterator<std::uint32_t*>;
+
+public:
+  explicit timer_wheel(size_type max_timers, tick_type now = 0)
+      : nodes_(max_timers), heads_(firing + 1), now_(now) {
+    for (size_type idx = 0; idx < max_timers; ++idx) {
+      nodes_.emplace_back();
+      nodes_[idx].next = idx + 1 < max_timers ? static_cast<std::uint32_t>(idx + 1) : npos;
+    }
+    free_ = max_timers > 0 ? 0 : npos;
+    for (size_type idx = 0; idx <= firing; ++idx) heads_.emplace_back(npos);
+    for (size_type level = 0; level < Levels; ++level) {
+      auto const first = heads_.data() + level * slots;
+      cursors_[level] = cursor_type(first, slots, (now_ >> (level * Bits)) & mask);
+    }
+  }
+  timer_wheel(timer_wheel const&) = delete;
+  timer_wheel& operator=(timer_wheel const&) = delete;
+
+  timer_id schedule(tick_type deadline, callback cb, std::uint64_t arg = 0) {
+    if (free_ == npos) return timer_id{};
+    auto const idx = free_;
+    auto& n = nodes_[idx];
+    free_ = n.next;
+    n.deadline = deadline;
+    n.cb = cb;
+    n.arg = arg;
+    place(idx, now_ + 1);
+    ++size_;
+    return timer_id{(std::uint64_t(n.generation) << 32) | idx};
+  }
+
+  bool cancel(timer_id id) {
+    if (!id) return false;
+    auto const idx = static_cast<std::uint32_t>(*id & npos);
+    if (idx >= nodes_.size()) return false;
+    auto& n = nodes_[idx];
+    if (n.generation != static_cast<std::uint32_t>(*id >> 32) || n.bucket == npos) return false;
+    unlink(idx);
+    release(idx);
+    return true;
+  }
+
+  size_type advance(tick_type now) {
+    size_type fired = 0;
+    while (now_ < now) fired += tick();
+    return fired;
+  }
+
+  tick_type now() const { return now_; }
+  size_type size() const { return size_; }
+  size_type capacity() const { return nodes_.capacity(); }
+  bool empty() const { return size_ == 0; }
+
+private:
+  size_type tick() {
+    ++now_;
+    for (size_type level = 0; level < Levels; ++level) {
+      ++cursors_[level];
+      normalize(cursors_[level]);
+      if (level + 1 == Levels || !on_boundary(level + 1)) break;
+    }
+    for (auto level = Levels - 1; level > 0; --level)
+      if (on_boundary(level)) cascade(level);
+
+    heads_[firing] = *cursors_[0];
+    *cursors_[0] = npos;
+    for (auto idx = heads_[firing]; idx != npos; idx = nodes_[idx].next)
+      nodes_[idx].bucket = firing;
+    size_type fired = 0;
+    while (heads_[firing] != npos) {
+      auto const idx = heads_[firing];
+      auto const cb = nodes_[idx].cb;
+      auto const arg = nodes_[idx].arg;
+      unlink(idx);
+      release(idx);
+      if (cb) cb(arg);
+      ++fired;
+    }
+    return fired;
+  }
+
+  bool on_boundary(size_type level) const {
+    return (now_ & ((tick_type(1) << (level * Bits)) - 1)) == 0;
+  }
+
+  void cascade(size_type level) {
+    auto idx = *cursors_[level];
+    *cursors_[level] = npos;
+    while (idx != npos) {
+      auto const next = nodes_[idx].next;
+      place(idx, now_);
+      idx = next;
+    }
+  }
+
+  void place(std::uint32_t idx, tick_type earliest) {
+    auto& n = nodes_[idx];
+    auto const deadline = n.deadline > earliest ? n.deadline : earliest;
+    auto const at = deadline - now_ < range ? deadline : now_ + range - 1;
+    auto const delta = at - now_;
+    size_type level = 0;
+    while (level + 1 < Levels && delta >= (tick_type(1) << ((level + 1) * Bits))) ++level;
+    auto const offset = (at >> (level * Bits)) - (now_ >> (level * Bits));
+    auto& head = *(cursors_[level] + offset);
+    n.bucket = static_cast<std::uint32_t>(&head - heads_.data());
+    n.prev = npos;
+    n.next = head;
+    if (head != npos) nodes_[head].prev = idx;
+    head = idx;
+  }
+
+  void unlink(std::uint32_t idx) {
+    auto& n = nodes_[idx];
+    if (n.prev != npos)
+      nodes_[n.prev].next = n.next;
+    else
+      heads_[n.bucket] = n.next;
+    if (n.next != npos) nodes_[n.next].prev = n.prev;
+  }
+
+  void release(std::uint32_t idx) {
+    auto& n = nodes_[idx];
+    n.bucket = npos;
+    n.cb = nullptr;
+    ++n.generation;
+    n.next = free_;
+    free_ = idx;
+    --size_;
+  }
+
+  heap_buffer<node> nodes_;
+  heap_buffer<std::uint32_t> heads_;
+  cursor_type cursors_[Levels];
+  tick_type now_;
+  std::uint32_t free_ = npos;
+  size_type size_ = 0;
+};
+
+template <std::size_t Levels, std::size_t Bits>
+constexpr std::uint32_t timer_wheel<Levels, Bits>::npos;
+template <std::size_t Levels, std::size_t Bits>
+constexpr std::size_t timer_wheel<Levels, Bits>::slots;
+template <std::size_t Levels, std::size_t Bits>
+constexpr std::uint64_t timer_wheel<Levels, Bits>::mask;
+template <std::size_t Levels, std::size_t Bits>
+constexpr std::uint64_t timer_wheel<Levels, Bits>::range;
+template <std::size_t Levels, std::size_t Bits>
+constexpr std::uint32_t timer_wheel<Levels, Bits>::firing;
+}
@@ -0,0 +1,104 @@
+#include <archie/atomic_alias.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+struct config {
+  config(int v, std::string n) : version(v), name(std::move(n)) {}
+  int version;
+  std::string name;
+};
+
+int freed = 0;
+struct count_delete {
+  void operator()(config* c) const {
+    ++freed;
+    delete c;
+  }
+};
+
+TEST_CASE("atomic_alias", "[atomic_alias]") {
+  freed = 0;
+  SECTION("read sees published object") {
+    epoch_domain domain(1);
+    atomic_alias<config, count_delete> cfg(new config(1, "one"), domain);
+    {
+      auto const r = cfg.read();
+      REQUIRE(r);
+      REQUIRE(r->version == 1);
+      REQUIRE((*r).name == "one");
+      alias_t<config const> const a = r.alias();
+      REQUIRE(a->name == "one");
+    }
+    cfg.emplace(2, "two");
+    REQUIRE(cfg.read()->version == 2);
+  }
+  SECTION("old object outlives readers") {
+    epoch_domain domain(1);
+    atomic_alias<config, count_delete> cfg(new config(1, "one"), domain);
+    {
+      auto const r = cfg.read();
+      cfg.publish(new config(2, "two"));
+      for (auto idx = 0; idx < 4; ++idx) domain.reclaim();
+      REQUIRE(freed == 0);
+      REQUIRE(r->name == "one");
+      REQUIRE(cfg.read()->name == "two");
+    }
+    domain.reclaim();
+    domain.reclaim();
+    REQUIRE(freed == 1);
+  }
+  SECTION("update copies and publishes") {
+    epoch_domain domain;
+    atomic_alias<config> cfg(new config(1, "one"), domain);
+    cfg.update([](config& c) { ++c.version; });
+    REQUIRE(cfg.read()->version == 2);
+    REQUIRE(cfg.read()->name == "one");
+  }
+  SECTION("null object") {
+    epoch_domain domain;
+    atomic_alias<config, count_delete> cfg(new config(1, "one"), domain);
+    cfg.publish(nullptr);
+    auto const r = cfg.read();
+    REQUIRE_FALSE(r);
+    REQUIRE_THROWS_AS(r.alias(), std::logic_error const&);
+    REQUIRE_THROWS_AS(cfg.update([](config& c) { ++c.version; }), std::logic_error const&);
+    cfg.emplace(2, "two");
+    cfg.update([](config& c) { ++c.version; });
+    REQUIRE(cfg.read()->version == 3);
+  }
+  SECTION("destructor retires current object") {
+    {
+      epoch_domain domain;
+      atomic_alias<config, count_delete> cfg(new config(1, "one"), domain);
+    }
+    REQUIRE(freed == 1);
+  }
+  SECTION("concurrent readers during hot swap") {
+    epoch_domain domain(16);
+    atomic_alias<config> cfg(new config(0, "0"), domain);
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> readers;
+    for (auto t = 0; t < 3; ++t)
+      readers.emplace_back([&] {
+        auto last = 0;
+        while (!stop) {
+          auto const r = cfg.read();
+          if (r->name != std::to_string(r->version) || r->version < last) ++errors;
+          last = r->version;
+        }
+      });
+    for (auto v = 1; v <= 20000; ++v) cfg.emplace(v, std::to_string(v));
+    stop = true;
+    for (auto& t : readers) t.join();
+    REQUIRE(errors == 0);
+    REQUIRE(cfg.read()->version == 20000);
+  }
+}
+}
@@ -0,0 +1,48 @@
+#include <archie/compose.hpp>
+#include <archie/pure_function.hpp>
+#include <catch.hpp>
+#include <string>
+#include <type_traits>
+namespace {
+using namespace archie;
+
+struct parse {
+  int operator()(std::string const& s) const { return std::stoi(s); }
+};
+struct normalize {
+  int operator()(int x) const { return x < 0 ? -x : x; }
+};
+struct hash {
+  unsigned operator()(int x) const { return static_cast<unsigned>(x) * 31u + 7u; }
+};
+
+int increment(int x) { return x + 1; }
+
+TEST_CASE("compose", "[compose]") {
+  SECTION("stateless stages fuse into one function object") {
+    auto const c = compose(hash{}, normalize{}, parse{});
+    static_assert(std::is_empty<std::decay_t<decltype(c)>>::value, "");
+    REQUIRE(c(std::string("-3")) == 100u);
+    pure_function<unsigned(std::string const&)> const pf{c};
+    REQUIRE(pf(std::string("4")) == 131u);
+  }
+  SECTION("single stage") {
+    auto const c = compose(normalize{});
+    REQUIRE(c(-5) == 5);
+  }
+  SECTION("stages with state are chained") {
+    auto const offset = 10;
+    pure_function<int(int)> const inc{increment};
+    auto const c = compose([offset](int x) { return x + offset; }, inc, normalize{});
+    static_assert(!std::is_empty<std::decay_t<decltype(c)>>::value, "");
+    REQUIRE(c(-3) == 14);
+    auto const d = compose(&increment, &increment);
+    REQUIRE(d(0) == 2);
+  }
+  SECTION("captureless lambdas are chained") {
+    auto const c = compose([](int x) { return x * 2; }, [](int x) { return x + 1; });
+    static_assert(!std::is_default_constructible<std::decay_t<decltype(c)>>::value, "");
+    REQUIRE(c(3) == 8);
+  }
+}
+}
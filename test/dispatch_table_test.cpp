@@ -0,0 +1,100 @@
+#include <archie/dispatch_table.hpp>
+#include <catch.hpp>
+#include <vector>
+namespace {
+using namespace archie;
+
+enum class code { push, add, mul, dup, count };
+
+struct instr {
+  code op;
+  int arg;
+};
+
+struct machine {
+  std::vector<int> stack;
+  int pop() {
+    auto const ret = stack.back();
+    stack.pop_back();
+    return ret;
+  }
+};
+
+struct push_h {
+  static constexpr code opcode = code::push;
+  void operator()(instr const& i, machine& m) const { m.stack.push_back(i.arg); }
+};
+struct add_h {
+  static constexpr code opcode = code::add;
+  void operator()(instr const&, machine& m) const { m.stack.push_back(m.pop() + m.pop()); }
+};
+struct mul_h {
+  static constexpr code opcode = code::mul;
+  void operator()(instr const&, machine& m) const { m.stack.push_back(m.pop() * m.pop()); }
+};
+struct dup_h {
+  static constexpr code opcode = code::dup;
+  void operator()(instr const&, machine& m) const { m.stack.push_back(m.stack.back()); }
+};
+
+using table_t = dispatch_table<void(instr const&, machine&), mul_h, push_h, dup_h, add_h>;
+
+enum class unary { neg, twice };
+struct neg_h {
+  static constexpr unary opcode = unary::neg;
+  int operator()(int x) const { return -x; }
+};
+struct twice_h {
+  static constexpr unary opcode = unary::twice;
+  int operator()(int x) const { return 2 * x; }
+};
+
+struct flip_h {
+  static constexpr unary opcode = unary::neg;
+  void operator()(unary const&, int& x) const { x = -x; }
+};
+struct double_h {
+  static constexpr unary opcode = unary::twice;
+  void operator()(unary const&, int& x) const { x *= 2; }
+};
+
+TEST_CASE("dispatch_table", "[dispatch_table]") {
+  SECTION("entries are ordered by opcode") {
+    using sut = dispatch_table<int(int), twice_h, neg_h>;
+    static_assert(sut::size == 2, "");
+    sut const t{};
+    REQUIRE(t(unary::neg, 3) == -3);
+    REQUIRE(t(unary::twice, 3) == 6);
+    REQUIRE(sut::at(unary::twice)(4) == 8);
+  }
+  SECTION("single dispatch") {
+    table_t const t{};
+    machine m;
+    t(code::push, instr{code::push, 2}, m);
+    t(code::dup, instr{code::dup, 0}, m);
+    t(code::mul, instr{code::mul, 0}, m);
+    REQUIRE(m.stack == std::vector<int>{4});
+  }
+  SECTION("run program") {
+    table_t const t{};
+    std::vector<instr> program;
+    program.push_back(instr{code::push, 1});
+    for (auto idx = 0; idx < 1000; ++idx) {
+      program.push_back(instr{code::push, 1});
+      program.push_back(instr{code::add, 0});
+    }
+    program.push_back(instr{code::dup, 0});
+    program.push_back(instr{code::mul, 0});
+    machine m;
+    REQUIRE(t.run(program.begin(), program.end(), m) == program.end());
+    REQUIRE(m.stack == std::vector<int>{1001 * 1001});
+  }
+  SECTION("program of bare opcodes") {
+    using sut = dispatch_table<void(unary const&, int&), flip_h, double_h>;
+    std::vector<unary> const program{unary::twice, unary::neg, unary::twice};
+    int x = 3;
+    sut{}.run(program.begin(), program.end(), x);
+    REQUIRE(x == -12);
+  }
+}
+}
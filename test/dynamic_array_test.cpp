@@ -1,5 +1,6 @@
 #include <archie/container/stack_buffer.hpp>
 #include <archie/container/heap_buffer.hpp>
+#include <archie/container/span_buffer.hpp>
 #include <resource.hpp>
 #include <catch.hpp>
 namespace {
@@ -297,4 +298,36 @@ TEST_CASE("mixed_buffer", "[array]") {
     REQUIRE(lhs != rhs);
   }
 }
+
+TEST_CASE("span_buffer", "[array]") {
+  using sut = span_buffer<test::resource>;
+  union storage {
+    storage() {}
+    ~storage() {}
+    test::resource data[3];
+  } store;
+  SECTION("ctor") {
+    sut buff(store.data, 3);
+    REQUIRE(buff.capacity() == 3);
+    REQUIRE(buff.empty());
+    REQUIRE(buff.data() == store.data);
+  }
+  SECTION("emplace_back") {
+    sut buff(store.data, 3);
+    buff.emplace_back(1);
+    buff.emplace_back(2);
+    REQUIRE(buff.size() == 2);
+    REQUIRE(buff[1] == 2);
+    REQUIRE(store.data[0] == 1);
+  }
+  SECTION("move ctor") {
+    sut orig(store.data, 3);
+    orig.emplace_back(1);
+    sut buff(std::move(orig));
+    REQUIRE(orig.empty());
+    REQUIRE(orig.capacity() == 0);
+    REQUIRE(buff.size() == 1);
+    REQUIRE(buff[0] == 1);
+  }
+}
 }
@@ -0,0 +1,147 @@
+#include <archie/epoch.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+struct node {
+  explicit node(int v) : value(v) {}
+  int value;
+  std::atomic<bool> dead{false};
+};
+
+struct bury {
+  void operator()(node* n) const {
+    n->dead = true;
+    graveyard->push_back(n);
+  }
+  std::vector<node*>* graveyard;
+};
+
+std::atomic<int> deleted{0};
+struct count_delete {
+  void operator()(int* p) const {
+    ++deleted;
+    delete p;
+  }
+};
+
+TEST_CASE("epoch_domain", "[epoch]") {
+  SECTION("retired objects outlive pinned readers") {
+    epoch_domain domain(1);
+    deleted = 0;
+    {
+      auto const g = domain.pin();
+      domain.retire(new int(1), count_delete{});
+      for (auto idx = 0; idx < 8; ++idx) domain.reclaim();
+      REQUIRE(deleted == 0);
+      REQUIRE(domain.pending() == 1);
+    }
+    domain.reclaim();
+    domain.reclaim();
+    REQUIRE(deleted == 1);
+    REQUIRE(domain.pending() == 0);
+  }
+  SECTION("nested pins") {
+    epoch_domain domain;
+    auto const start = domain.epoch();
+    {
+      auto const outer = domain.pin();
+      {
+        auto const inner = domain.pin();
+      }
+      REQUIRE(domain.try_advance());
+      REQUIRE_FALSE(domain.try_advance());
+    }
+    REQUIRE(domain.try_advance());
+    REQUIRE(domain.epoch() == start + 2);
+  }
+  SECTION("destructor reclaims remaining objects") {
+    deleted = 0;
+    {
+      epoch_domain domain(1024);
+      for (auto idx = 0; idx < 10; ++idx) domain.retire(new int(idx), count_delete{});
+    }
+    REQUIRE(deleted == 10);
+  }
+  SECTION("objects retired by an exited thread are reclaimed") {
+    epoch_domain domain(1024);
+    deleted = 0;
+    std::thread([&domain] {
+      for (auto idx = 0; idx < 10; ++idx) domain.retire(new int(idx), count_delete{});
+    }).join();
+    REQUIRE(deleted == 0);
+    for (auto idx = 0; idx < 3; ++idx) domain.reclaim();
+    REQUIRE(deleted == 10);
+  }
+  SECTION("threads alternate between domains") {
+    epoch_domain first(1);
+    epoch_domain second(1);
+    deleted = 0;
+    for (auto idx = 0; idx < 100; ++idx) {
+      auto const a = first.pin();
+      auto const b = second.pin();
+      first.retire(new int(idx), count_delete{});
+      second.retire(new int(idx), count_delete{});
+    }
+    REQUIRE(first.pending() + second.pending() <= 4);
+    first.reclaim();
+    first.reclaim();
+    second.reclaim();
+    second.reclaim();
+    REQUIRE(deleted == 200);
+  }
+  SECTION("a long pin does not stall retire") {
+    epoch_domain domain(1, 4);
+    deleted = 0;
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&] {
+      auto const g = domain.pin();
+      pinned = true;
+      while (!release) std::this_thread::yield();
+    });
+    while (!pinned) std::this_thread::yield();
+    for (auto idx = 0; idx < 16; ++idx) domain.retire(new int(idx), count_delete{});
+    REQUIRE(domain.pending() + static_cast<std::size_t>(deleted) == 16);
+    REQUIRE(domain.pending() > 4);
+    release = true;
+    reader.join();
+    while (domain.pending() != 0) domain.reclaim();
+    REQUIRE(deleted == 16);
+  }
+  SECTION("stress: readers never observe reclaimed nodes and memory stays bounded") {
+    epoch_domain domain(64);
+    std::vector<node*> graveyard;
+    std::atomic<node*> shared{new node(0)};
+    std::atomic<bool> stop{false};
+    std::atomic<int> violations{0};
+    std::vector<std::thread> readers;
+    for (auto t = 0; t < 3; ++t)
+      readers.emplace_back([&] {
+        while (!stop) {
+          auto const g = domain.pin();
+          auto const n = shared.load(std::memory_order_acquire);
+          if (n->dead) ++violations;
+        }
+      });
+    std::size_t peak = 0;
+    for (auto idx = 1; idx <= 100000; ++idx) {
+      auto const old = shared.exchange(new node(idx), std::memory_order_acq_rel);
+      domain.retire(old, bury{&graveyard});
+      auto const p = domain.pending();
+      if (p > peak) peak = p;
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+    REQUIRE(violations == 0);
+    REQUIRE(peak <= 16 * 64);
+    while (domain.pending() != 0) domain.reclaim();
+    REQUIRE(graveyard.size() == 100000);
+    for (auto n : graveyard) delete n;
+    delete shared.load();
+  }
+}
+}
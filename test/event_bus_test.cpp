@@ -0,0 +1,103 @@
+#include <archie/event_bus.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+struct topic_tag {};
+using topic = opaque<topic_tag,
+                     std::uint32_t,
+                     feature::equivalent<feature::self>,
+                     feature::ordered<feature::self>>;
+
+struct event {
+  int value;
+};
+
+int total = 0;
+std::vector<int> order;
+
+void add(event const& e) { total += e.value; }
+void record_a(event const& e) { order.push_back(e.value); }
+void record_b(event const& e) { order.push_back(-e.value); }
+
+std::atomic<int> seen(0);
+void count(event const&) { ++seen; }
+
+event_bus<event, topic>* target = nullptr;
+void subscribe_more(event const& e) {
+  target->subscribe(topic(static_cast<std::uint32_t>(e.value)), add);
+}
+
+TEST_CASE("event_bus", "[event_bus]") {
+  using sut = event_bus<event, topic>;
+  total = 0;
+  order.clear();
+  sut bus;
+  topic const prices(1u), trades(2u), news(3u);
+  SECTION("publish reaches subscribers of the topic only") {
+    bus.subscribe(trades, add);
+    bus.subscribe(prices, add);
+    bus.subscribe(prices, add);
+    REQUIRE(bus.subscribers(prices) == 2);
+    REQUIRE(bus.subscribers(news) == 0);
+    REQUIRE(bus.publish(prices, event{5}) == 2);
+    REQUIRE(total == 10);
+    REQUIRE(bus.publish(news, event{5}) == 0);
+    REQUIRE(total == 10);
+  }
+  SECTION("unsubscribe") {
+    bus.subscribe(prices, add);
+    bus.subscribe(prices, record_a);
+    REQUIRE(bus.unsubscribe(prices, add));
+    REQUIRE_FALSE(bus.unsubscribe(prices, add));
+    REQUIRE_FALSE(bus.unsubscribe(news, add));
+    bus.publish(prices, event{3});
+    REQUIRE(total == 0);
+    REQUIRE(order == std::vector<int>{3});
+    REQUIRE(bus.unsubscribe(prices, record_a));
+    REQUIRE(bus.subscribers(prices) == 0);
+  }
+  SECTION("batch is dispatched handler-major") {
+    bus.subscribe(prices, record_a);
+    bus.subscribe(prices, record_b);
+    std::vector<event> const batch{{1}, {2}, {3}};
+    REQUIRE(bus.publish_batch(prices, batch.begin(), batch.end()) == 2);
+    REQUIRE(order == (std::vector<int>{1, 2, 3, -1, -2, -3}));
+  }
+  SECTION("handlers may not mutate the bus they are published from") {
+    bus.subscribe(prices, subscribe_more);
+    target = &bus;
+    REQUIRE_THROWS_AS(bus.publish(prices, event{2}), std::logic_error const&);
+    REQUIRE(bus.subscribers(trades) == 0);
+    sut other;
+    target = &other;
+    REQUIRE(bus.publish(prices, event{2}) == 1);
+    REQUIRE(other.subscribers(trades) == 1);
+    bus.subscribe(trades, add);
+    REQUIRE(bus.subscribers(trades) == 1);
+  }
+  SECTION("subscribe while publishing") {
+    seen = 0;
+    bus.subscribe(prices, count);
+    std::atomic<bool> done(false);
+    std::vector<std::thread> publishers;
+    for (auto t = 0; t < 3; ++t)
+      publishers.emplace_back([&] {
+        while (!done) bus.publish(prices, event{1});
+      });
+    for (auto idx = 0; idx < 200; ++idx) {
+      bus.subscribe(trades, count);
+      bus.unsubscribe(trades, count);
+    }
+    done = true;
+    for (auto& t : publishers) t.join();
+    REQUIRE(bus.subscribers(prices) == 1);
+    REQUIRE(bus.subscribers(trades) == 0);
+  }
+}
+}
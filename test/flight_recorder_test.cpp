@@ -0,0 +1,141 @@
+#include <archie/flight_recorder.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+namespace {
+using namespace archie;
+TEST_CASE("flight_recorder", "[flight_recorder]") {
+  auto& recorder = flight_recorder::instance();
+  recorder.configure(8);
+  std::vector<flight_event> earlier;
+  recorder.merge(std::back_inserter(earlier));
+  std::promise<void> done;
+  std::shared_future<void> const finished = done.get_future().share();
+  std::vector<std::thread> threads;
+  std::vector<std::promise<void>> ready(3);
+  for (std::uint32_t t = 0; t < 3; ++t) {
+    threads.emplace_back([t, &ready, finished] {
+      for (std::uint64_t idx = 0; idx < 20; ++idx) flight_recorder::record(t, idx);
+      ready[t].set_value();
+      finished.wait();
+    });
+  }
+  for (auto& r : ready) r.get_future().wait();
+
+  SECTION("rings are bounded and enumerable") {
+    std::size_t rings = 0;
+    recorder.for_each_ring([&rings](std::uint32_t, flight_recorder::ring_type const& r) {
+      REQUIRE(r.size() == 8);
+      REQUIRE(r.front().args[0] == 12);
+      REQUIRE(r.back().args[0] == 19);
+      ++rings;
+    });
+    REQUIRE(rings == 3);
+  }
+  SECTION("merge is ordered by timestamp") {
+    std::vector<flight_event> events;
+    REQUIRE(recorder.merge(std::back_inserter(events)) == 24);
+    REQUIRE(std::is_sorted(
+        events.begin(), events.end(), [](flight_event const& lhs, flight_event const& rhs) {
+          return lhs.timestamp < rhs.timestamp;
+        }));
+  }
+  SECTION("dump writes merged events to file") {
+    char path[] = "/tmp/flight_recorder_testXXXXXX";
+    auto const fd = ::mkstemp(path);
+    REQUIRE(fd >= 0);
+    ::close(fd);
+    REQUIRE(recorder.dump(path) == 24);
+    auto const f = std::fopen(path, "rb");
+    REQUIRE(f != nullptr);
+    std::fseek(f, 0, SEEK_END);
+    REQUIRE(std::ftell(f) == static_cast<long>(24 * sizeof(flight_event)));
+    std::fclose(f);
+    std::remove(path);
+  }
+  done.set_value();
+  for (auto& t : threads) t.join();
+}
+
+TEST_CASE("flight_recorder merge while threads exit", "[flight_recorder]") {
+  auto& recorder = flight_recorder::instance();
+  recorder.configure(64);
+  std::vector<flight_event> events;
+  recorder.merge(std::back_inserter(events));
+  events.clear();
+  std::atomic<bool> stop{false};
+  std::atomic<std::uint64_t> spawned{0};
+  std::thread churn([&stop, &spawned] {
+    while (!stop) {
+      auto const seq = spawned.load();
+      std::thread([seq] { flight_recorder::record(1, seq); }).join();
+      spawned = seq + 1;
+    }
+  });
+  for (auto idx = 0; idx < 200 || spawned < 100; ++idx) recorder.merge(std::back_inserter(events));
+  stop = true;
+  churn.join();
+  recorder.merge(std::back_inserter(events));
+  std::vector<std::uint64_t> seen;
+  for (auto const& e : events)
+    if (e.code == 1) seen.push_back(e.args[0]);
+  std::sort(seen.begin(), seen.end());
+  REQUIRE(std::adjacent_find(seen.begin(), seen.end()) == seen.end());
+  REQUIRE_FALSE(seen.empty());
+  REQUIRE(seen.back() == spawned - 1);
+  REQUIRE(seen.size() <= spawned);
+}
+
+TEST_CASE("flight_recorder keeps rings of exited threads until merged", "[flight_recorder]") {
+  auto& recorder = flight_recorder::instance();
+  recorder.configure(16);
+  std::vector<flight_event> events;
+  recorder.merge(std::back_inserter(events));
+  events.clear();
+  for (std::uint64_t t = 0; t < 3; ++t)
+    std::thread([t] {
+      for (std::uint64_t idx = 0; idx < 4; ++idx) flight_recorder::record(2, t, idx);
+    }).join();
+  REQUIRE(recorder.merge(std::back_inserter(events)) == 12);
+  for (std::uint64_t t = 0; t < 3; ++t) {
+    std::uint64_t next = 0;
+    for (auto const& e : events)
+      if (e.args[0] == t) REQUIRE(e.args[1] == next++);
+    REQUIRE(next == 4);
+  }
+  events.clear();
+  REQUIRE(recorder.merge(std::back_inserter(events)) == 0);
+}
+
+TEST_CASE("flight_recorder mmap mode", "[flight_recorder]") {
+  char dir[] = "/tmp/flight_recorder_testXXXXXX";
+  REQUIRE(::mkdtemp(dir) != nullptr);
+  flight_recorder::instance().configure(4, dir);
+  std::thread([] { flight_recorder::record(7, 1, 2); }).join();
+  flight_recorder::instance().configure(4096);
+  auto const d = ::opendir(dir);
+  REQUIRE(d != nullptr);
+  std::string path;
+  while (auto const entry = ::readdir(d))
+    if (entry->d_name[0] != '.') path = std::string(dir) + "/" + entry->d_name;
+  ::closedir(d);
+  auto const f = std::fopen(path.c_str(), "rb");
+  REQUIRE(f != nullptr);
+  flight_event ev[4];
+  REQUIRE(std::fread(ev, sizeof(flight_event), 4, f) == 4);
+  std::fclose(f);
+  REQUIRE(ev[0].code == 7);
+  REQUIRE(ev[0].args[1] == 2);
+  REQUIRE(ev[1].timestamp == 0);
+  std::remove(path.c_str());
+  ::rmdir(dir);
+}
+}
@@ -0,0 +1,53 @@
+#include <archie/function_ref.hpp>
+#include <archie/pure_function.hpp>
+#include <catch.hpp>
+#include <string>
+#include <type_traits>
+namespace {
+using namespace archie;
+
+using ref_t = function_ref<int(int)>;
+static_assert(std::is_trivially_copyable<ref_t>::value, "");
+static_assert(sizeof(ref_t) == 2 * sizeof(void*), "");
+
+int twice(int x) { return 2 * x; }
+
+int apply(ref_t f, int x) { return f(x); }
+
+struct offset {
+  int operator()(int x) { return x + ++calls; }
+  int calls = 0;
+};
+
+TEST_CASE("function_ref", "[function_ref]") {
+  SECTION("binds to free function") {
+    REQUIRE(apply(twice, 3) == 6);
+    REQUIRE(apply(&twice, 4) == 8);
+  }
+  SECTION("binds to captureless lambda and pure_function") {
+    REQUIRE(apply([](int x) { return x - 1; }, 3) == 2);
+    pure_function<int(int)> const pf{twice};
+    REQUIRE(apply(pf, 5) == 10);
+  }
+  SECTION("binds to stateful lambda on the stack") {
+    auto const k = 10;
+    REQUIRE(apply([k](int x) { return x * k; }, 3) == 30);
+  }
+  SECTION("refers to the callable, not a copy") {
+    offset o;
+    ref_t f(o);
+    REQUIRE(f(1) == 2);
+    REQUIRE(f(1) == 3);
+    REQUIRE(o.calls == 2);
+    auto g = f;
+    REQUIRE(g(0) == 3);
+    REQUIRE(o.calls == 3);
+  }
+  SECTION("reference arguments") {
+    std::string s = "a";
+    function_ref<void(std::string&)> f([](std::string& x) { x += "b"; });
+    f(s);
+    REQUIRE(s == "ab");
+  }
+}
+}
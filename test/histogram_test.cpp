@@ -0,0 +1,82 @@
+#include <archie/histogram.hpp>
+#include <catch.hpp>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+namespace {
+using namespace archie;
+using sut = log_histogram<6>;
+
+TEST_CASE("log_histogram buckets", "[histogram]") {
+  for (std::uint64_t v : {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123456789ull, ~0ull}) {
+    auto const idx = sut::index_of(v);
+    REQUIRE(idx < sut::bucket_count);
+    REQUIRE(sut::lowest_of(idx) <= v);
+    REQUIRE(sut::highest_of(idx) >= v);
+  }
+  REQUIRE(sut::index_of(~0ull) == sut::bucket_count - 1);
+}
+
+TEST_CASE("log_histogram", "[histogram]") {
+  auto h = std::make_unique<sut>();
+  SECTION("empty") {
+    REQUIRE(h->count() == 0);
+    REQUIRE(h->value_at(99.0) == 0);
+  }
+  SECTION("percentiles within relative error") {
+    for (std::uint64_t v = 1; v <= 100000; ++v) h->record(v);
+    REQUIRE(h->count() == 100000);
+    REQUIRE(h->min() == 1);
+    REQUIRE(h->max() == 100000);
+    for (auto p : {50.0, 90.0, 99.0, 99.9}) {
+      auto const expected = p * 1000.0;
+      auto const actual = static_cast<double>(h->value_at(p));
+      REQUIRE(actual >= expected);
+      REQUIRE(actual <= expected * (1.0 + 1.0 / 32.0));
+    }
+    REQUIRE(h->value_at(100.0) == 100000);
+  }
+  SECTION("merge") {
+    auto other = std::make_unique<sut>();
+    h->record(10, 3);
+    other->record(2000);
+    *h += *other;
+    REQUIRE(h->count() == 4);
+    REQUIRE(h->min() == 10);
+    REQUIRE(h->max() == 2000);
+    REQUIRE(h->value_at(50.0) == 10);
+  }
+  SECTION("serialize round trip") {
+    h->record(5);
+    h->record(70000, 7);
+    h->record(123456789);
+    std::vector<std::uint8_t> bytes;
+    h->serialize(std::back_inserter(bytes));
+    REQUIRE(bytes.size() < 32);
+    auto copy = std::make_unique<sut>();
+    REQUIRE(copy->deserialize(bytes.begin(), bytes.end()));
+    REQUIRE(copy->count() == h->count());
+    REQUIRE(copy->min() == 5);
+    REQUIRE(copy->max() == 123456789);
+    for (std::size_t idx = 0; idx < sut::bucket_count; ++idx) REQUIRE((*copy)[idx] == (*h)[idx]);
+    bytes.pop_back();
+    REQUIRE_FALSE(copy->deserialize(bytes.begin(), bytes.end()));
+  }
+}
+
+TEST_CASE("windowed_histogram", "[histogram]") {
+  windowed_histogram<6> w(2);
+  w.record(1);
+  w.rotate();
+  w.record(2);
+  REQUIRE(w.snapshot().count() == 2);
+  w.rotate();
+  w.record(3);
+  REQUIRE(w.size() == 2);
+  auto const s = w.snapshot();
+  REQUIRE(s.count() == 2);
+  REQUIRE(s.min() == 2);
+  REQUIRE(w.current().count() == 1);
+}
+}
@@ -0,0 +1,79 @@
+#include <archie/inplace_function.hpp>
+#include <catch.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+namespace {
+using namespace archie;
+
+using fn_t = inplace_function<int(int), 32>;
+using unique_fn_t = inplace_function<int(int), 32, alignof(std::max_align_t),
+                                     function_policy::move_only>;
+
+struct counted {
+  explicit counted(int& n) : alive(&n) { ++*alive; }
+  counted(counted const& other) : alive(other.alive) { ++*alive; }
+  counted(counted&& other) : alive(other.alive) { ++*alive; }
+  ~counted() { --*alive; }
+  int operator()(int x) const { return x + *alive; }
+  int* alive;
+};
+
+TEST_CASE("inplace_function", "[inplace_function]") {
+  SECTION("default constructed is empty") {
+    fn_t f;
+    REQUIRE(!f);
+    fn_t g(nullptr);
+    REQUIRE(!g);
+    REQUIRE_THROWS_AS(f(1), std::bad_function_call const&);
+    REQUIRE_THROWS_AS(g(1), std::bad_function_call const&);
+  }
+  SECTION("stores stateful lambda") {
+    auto const a = 3l, b = 4l, c = 5l;
+    fn_t f([a, b, c](int x) { return static_cast<int>(a * b * c) + x; });
+    REQUIRE(f);
+    REQUIRE(f(1) == 61);
+    f = [](int x) { return -x; };
+    REQUIRE(f(2) == -2);
+    f = nullptr;
+    REQUIRE(!f);
+  }
+  SECTION("mutable state is kept") {
+    fn_t f([n = 0](int x) mutable { return n += x; });
+    REQUIRE(f(1) == 1);
+    REQUIRE(f(2) == 3);
+  }
+  SECTION("copy and move") {
+    int alive = 0;
+    {
+      fn_t f{counted(alive)};
+      REQUIRE(alive == 1);
+      fn_t g(f);
+      REQUIRE(alive == 2);
+      fn_t h(std::move(f));
+      REQUIRE(!f);
+      REQUIRE(alive == 2);
+      g = h;
+      REQUIRE(alive == 2);
+      REQUIRE(h(0) == 2);
+    }
+    REQUIRE(alive == 0);
+  }
+  SECTION("move only policy") {
+    static_assert(!std::is_copy_constructible<unique_fn_t>::value, "");
+    static_assert(std::is_move_constructible<unique_fn_t>::value, "");
+    static_assert(std::is_copy_constructible<fn_t>::value, "");
+    unique_fn_t f([p = std::make_unique<int>(7)](int x) { return *p + x; });
+    unique_fn_t g(std::move(f));
+    REQUIRE(!f);
+    REQUIRE(g(1) == 8);
+  }
+  SECTION("reference arguments") {
+    inplace_function<void(std::string&)> f([](std::string& s) { s += "!"; });
+    std::string s = "hi";
+    f(s);
+    REQUIRE(s == "hi!");
+  }
+}
+}
@@ -0,0 +1,147 @@
+#include <archie/io_ring.hpp>
+#include <catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+namespace {
+using namespace archie;
+
+long results[64];
+std::uint64_t completed = 0;
+
+void on_complete(std::uint64_t user, long res) {
+  results[user] = res;
+  ++completed;
+}
+io_ring::completion const record{on_complete};
+
+io_ring* active = nullptr;
+int active_fd = -1;
+char scratch[4];
+
+void resubmit(std::uint64_t user, long) {
+  if (++completed < 4)
+    active->read(active_fd, scratch, sizeof(scratch), 0, io_ring::completion{resubmit}, user);
+}
+
+struct temp_fd {
+  temp_fd() {
+    char name[] = "/tmp/archie_io_ring_XXXXXX";
+    fd = ::mkstemp(name);
+    ::unlink(name);
+  }
+  ~temp_fd() { ::close(fd); }
+  int fd;
+};
+
+void exercise(io_backend backend) {
+  temp_fd const tmp;
+  io_ring ring(8, 4, backend);
+  completed = 0;
+  SECTION("write then read back in batches") {
+    heap_buffer<std::uint32_t> out(1024);
+    for (std::uint32_t idx = 0; idx < 1024; ++idx) out.emplace_back(idx * 7);
+    for (std::uint64_t chunk = 0; chunk < 16; ++chunk)
+      ring.write(tmp.fd, out.data() + chunk * 64, 256, chunk * 256, record, chunk);
+    REQUIRE(ring.drain() == 16);
+    REQUIRE(completed == 16);
+    for (auto idx = 0; idx < 16; ++idx) REQUIRE(results[idx] == 256);
+
+    heap_buffer<std::uint32_t> in(1024);
+    for (auto idx = 0; idx < 1024; ++idx) in.emplace_back(0u);
+    for (std::uint64_t chunk = 0; chunk < 16; ++chunk)
+      ring.read(tmp.fd, in.data() + chunk * 64, 256, chunk * 256, record, chunk);
+    ring.submit();
+    ring.drain();
+    REQUIRE(completed == 32);
+    REQUIRE(ring.in_flight() == 0);
+    for (std::uint32_t idx = 0; idx < 1024; ++idx) REQUIRE(in[idx] == idx * 7);
+  }
+  SECTION("errors are reported as negative errno") {
+    char buf[16];
+    ring.read(-1, buf, sizeof(buf), 0, record, 3);
+    ring.submit();
+    REQUIRE(ring.wait() == 1);
+    REQUIRE(results[3] == -EBADF);
+  }
+  SECTION("registered files") {
+    char const text[] = "registered";
+    REQUIRE(::pwrite(tmp.fd, text, sizeof(text), 0) == sizeof(text));
+    int const fds[] = {tmp.fd};
+    ring.register_files(fds, 1);
+    char buf[sizeof(text)] = {};
+    ring.read(fixed_file{0}, buf, sizeof(buf), 0, record, 5);
+    ring.drain();
+    REQUIRE(results[5] == sizeof(text));
+    REQUIRE(std::string(buf) == text);
+  }
+  SECTION("registered buffers") {
+    char const text[] = "fixed buffer";
+    REQUIRE(::pwrite(tmp.fd, text, sizeof(text), 0) == sizeof(text));
+    char buf[64] = {};
+    iovec const iov{buf, sizeof(buf)};
+    ring.register_buffers(&iov, 1);
+    ring.read_fixed(tmp.fd, 0, buf, sizeof(text), 0, record, 6);
+    ring.drain();
+    REQUIRE(results[6] == sizeof(text));
+    REQUIRE(std::string(buf) == text);
+  }
+  SECTION("poll without submission completes nothing") {
+    char buf[4];
+    ring.read(tmp.fd, buf, sizeof(buf), 0, record, 7);
+    REQUIRE(ring.in_flight() == 1);
+    REQUIRE(ring.poll() == 0);
+    REQUIRE(ring.in_flight() == 1);
+    REQUIRE(completed == 0);
+    ring.drain();
+    REQUIRE(completed == 1);
+    REQUIRE(ring.in_flight() == 0);
+  }
+  SECTION("completions may queue more requests") {
+    io_ring eager(2, 1, backend);
+    active = &eager;
+    active_fd = tmp.fd;
+    eager.read(tmp.fd, scratch, sizeof(scratch), 0, io_ring::completion{resubmit}, 8);
+    eager.drain();
+    REQUIRE(completed == 4);
+    REQUIRE(eager.in_flight() == 0);
+  }
+  SECTION("oversized lengths are rejected") {
+    char buf[4];
+    auto const huge = io_ring::size_type(std::numeric_limits<std::uint32_t>::max()) + 1;
+    REQUIRE_THROWS_AS(ring.read(tmp.fd, buf, huge, 0, record, 9), std::length_error const&);
+    REQUIRE(ring.in_flight() == 0);
+  }
+  SECTION("destruction waits for requests in flight") {
+    char buf[4];
+    {
+      io_ring scoped(8, 4, backend);
+      scoped.read(tmp.fd, buf, sizeof(buf), 0, record, 10);
+    }
+    REQUIRE(completed == 1);
+  }
+}
+
+TEST_CASE("io_ring sync backend", "[io_ring]") {
+  io_ring const ring(8, 4, io_backend::sync);
+  REQUIRE_FALSE(ring.uses_uring());
+  exercise(io_backend::sync);
+}
+
+TEST_CASE("io_ring automatic backend", "[io_ring]") { exercise(io_backend::automatic); }
+
+TEST_CASE("io_ring uring backend is used or refused", "[io_ring]") {
+  io_ring const automatic(8, 4);
+  if (automatic.uses_uring()) {
+    io_ring const ring(8, 4, io_backend::uring);
+    REQUIRE(ring.uses_uring());
+  } else {
+    REQUIRE_THROWS_AS(io_ring(8, 4, io_backend::uring), std::system_error const&);
+  }
+}
+}
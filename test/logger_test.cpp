@@ -0,0 +1,145 @@
+#include <archie/logger.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+std::string read_all(std::FILE* f) {
+  std::string ret;
+  std::rewind(f);
+  char buff[256];
+  for (std::size_t n; (n = std::fread(buff, 1, sizeof(buff), f)) > 0;) ret.append(buff, n);
+  return ret;
+}
+
+void format_pair(std::string& out, int const& a, double const& b) {
+  out += std::to_string(a);
+  out += ':';
+  out += std::to_string(static_cast<int>(b * 10));
+}
+
+std::atomic<bool> gate(true);
+
+logger* nested = nullptr;
+void log_again(std::string& out, int const& v) {
+  out += std::to_string(v);
+  if (v > 0) nested->log(log_again, v - 1);
+}
+
+TEST_CASE("logger", "[logger]") {
+  auto const f = std::tmpfile();
+  REQUIRE(f != nullptr);
+  SECTION("formats records on the writer thread") {
+    {
+      logger log(f);
+      REQUIRE(log.log(format_pair, 7, 1.5));
+      REQUIRE(log.log([](std::string& out, char const& c) { out += c; }, 'x'));
+      REQUIRE(log.log([](std::string& out) { out += "plain"; }));
+      log.flush();
+      auto const text = read_all(f);
+      REQUIRE(text.find(" 7:15\n") != std::string::npos);
+      REQUIRE(text.find(" x\n") != std::string::npos);
+      REQUIRE(text.find(" plain\n") != std::string::npos);
+    }
+  }
+  SECTION("timestamps are steady_clock nanoseconds") {
+    std::uint64_t before = 0;
+    std::uint64_t after = 0;
+    {
+      logger log(f);
+      before = detail::steady_ns();
+      log.log([](std::string& out) { out += "stamp"; });
+      after = detail::steady_ns();
+      log.flush();
+    }
+    auto const text = read_all(f);
+    auto const stamp = std::stoull(text.substr(0, text.find(' ')));
+    REQUIRE(stamp + 1000000 >= before);
+    REQUIRE(stamp <= after + 1000000);
+  }
+  SECTION("formatters may log from the writer thread") {
+    {
+      logger log(f, 64, overflow_policy::block);
+      nested = &log;
+      log.log(log_again, 3);
+      log.flush();
+      REQUIRE(log.producers() == 2);
+    }
+    auto const text = read_all(f);
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 4);
+  }
+  SECTION("records from many threads") {
+    {
+      logger log(f, 1024, overflow_policy::block);
+      std::vector<std::thread> threads;
+      for (auto t = 0; t < 4; ++t)
+        threads.emplace_back([&log, t] {
+          for (auto idx = 0; idx < 1000; ++idx) log.log(format_pair, t, 0.0);
+        });
+      for (auto& t : threads) t.join();
+    }
+    auto const text = read_all(f);
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 4000);
+  }
+  SECTION("one queue per thread and logger") {
+    auto const g = std::tmpfile();
+    {
+      logger first(f, 64, overflow_policy::block);
+      logger second(g, 64, overflow_policy::block);
+      for (auto idx = 0; idx < 1000; ++idx) {
+        first.log(format_pair, idx, 0.0);
+        second.log(format_pair, idx, 0.0);
+      }
+      REQUIRE(first.producers() == 1);
+      REQUIRE(second.producers() == 1);
+      for (auto t = 0; t < 20; ++t)
+        std::thread([&first] { first.log(format_pair, -1, 0.0); }).join();
+      REQUIRE(first.producers() == 2);
+    }
+    auto const text = read_all(f);
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 1020);
+    REQUIRE(text.find(" 0:0\n") < text.find(" 999:0\n"));
+    auto const other = read_all(g);
+    REQUIRE(std::count(other.begin(), other.end(), '\n') == 1000);
+    std::fclose(g);
+  }
+  SECTION("loggers of different record sizes keep separate queues") {
+    auto const g = std::tmpfile();
+    {
+      basic_logger<48> narrow(f, 64, overflow_policy::block);
+      basic_logger<56> wide(g, 64, overflow_policy::block);
+      for (auto idx = 0; idx < 100; ++idx) {
+        narrow.log(format_pair, idx, 0.0);
+        wide.log(format_pair, idx, 0.0);
+      }
+      REQUIRE(narrow.producers() == 1);
+      REQUIRE(wide.producers() == 1);
+    }
+    auto const text = read_all(f);
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 100);
+    auto const other = read_all(g);
+    REQUIRE(std::count(other.begin(), other.end(), '\n') == 100);
+    std::fclose(g);
+  }
+  SECTION("drop policy") {
+    gate = false;
+    {
+      logger log(f, 2, overflow_policy::drop);
+      auto const stall = [](std::string&) {
+        while (!gate) std::this_thread::yield();
+      };
+      log.log(stall);
+      while (!log.log([](std::string&) {})) {}
+      while (log.log([](std::string&) {})) {}
+      REQUIRE(log.dropped() > 0);
+      gate = true;
+    }
+  }
+  std::fclose(f);
+}
+}
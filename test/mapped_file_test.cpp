@@ -0,0 +1,68 @@
+#include <archie/mapped_file.hpp>
+#include <catch.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+namespace {
+using namespace archie;
+
+struct record {
+  std::uint32_t id;
+  float value;
+};
+
+struct temp_file {
+  temp_file() {
+    char name[] = "/tmp/archie_mapped_XXXXXX";
+    auto const fd = ::mkstemp(name);
+    ::close(fd);
+    path = name;
+  }
+  ~temp_file() { std::remove(path.c_str()); }
+  void write(void const* p, std::size_t n) const {
+    auto const f = std::fopen(path.c_str(), "wb");
+    std::fwrite(p, 1, n, f);
+    std::fclose(f);
+  }
+  std::string path;
+};
+
+TEST_CASE("mapped_file", "[mapped_file]") {
+  temp_file const tmp;
+  SECTION("typed view over records") {
+    record records[1000];
+    for (std::uint32_t idx = 0; idx < 1000; ++idx)
+      records[idx] = record{idx, static_cast<float>(idx) / 2};
+    tmp.write(records, sizeof(records));
+    mapped_file const f(tmp.path);
+    REQUIRE(f.size() == sizeof(records));
+    f.advise(access::sequential);
+    f.advise(access::willneed, 100, 4000);
+    auto const view = f.as<record>();
+    REQUIRE(view.size() == 1000);
+    REQUIRE(view[0].id == 0);
+    REQUIRE(view[999].value == 999.0f / 2);
+    std::uint32_t expected = 0;
+    for (auto const& r : view) REQUIRE(r.id == expected++);
+    REQUIRE(f.as<std::uint64_t>().size() == sizeof(records) / sizeof(std::uint64_t));
+  }
+  SECTION("partial trailing record is not exposed") {
+    char const bytes[] = "abcdefghij";
+    tmp.write(bytes, 10);
+    mapped_file const f(tmp.path);
+    REQUIRE(f.as<std::uint32_t>().size() == 2);
+    REQUIRE(f.data()[9] == 'j');
+  }
+  SECTION("empty file") {
+    mapped_file const f(tmp.path);
+    REQUIRE(f.empty());
+    REQUIRE(f.as<record>().empty());
+    f.advise(access::random);
+  }
+  SECTION("missing file throws") {
+    REQUIRE_THROWS_AS(mapped_file(tmp.path + ".missing"), std::system_error const&);
+  }
+}
+}
@@ -0,0 +1,93 @@
+#include <archie/memoized.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+std::atomic<int> calls(0);
+
+int square(int x) {
+  ++calls;
+  return x * x;
+}
+
+std::size_t length(std::string const& s, int n) {
+  ++calls;
+  return s.size() * static_cast<std::size_t>(n);
+}
+
+struct same_set {
+  template <typename... T>
+  std::size_t operator()(T const&...) const {
+    return 0;
+  }
+};
+
+using square_fn = pure_function<int(int)>;
+
+TEST_CASE("memoized", "[memoized]") {
+  calls = 0;
+  SECTION("repeated calls hit the cache") {
+    memoized<square_fn, 64> sut(square_fn{square});
+    REQUIRE(sut.capacity() == 64);
+    REQUIRE(sut(3) == 9);
+    REQUIRE(sut(3) == 9);
+    REQUIRE(sut(4) == 16);
+    REQUIRE(sut(3) == 9);
+    REQUIRE(calls == 2);
+    REQUIRE(sut.hits() == 2);
+    REQUIRE(sut.misses() == 2);
+    sut.clear();
+    REQUIRE(sut(3) == 9);
+    REQUIRE(calls == 3);
+  }
+  SECTION("multiple arguments") {
+    using fn = pure_function<std::size_t(std::string const&, int)>;
+    memoized<fn, 16> sut(fn{length});
+    REQUIRE(sut(std::string("abc"), 2) == 6);
+    REQUIRE(sut(std::string("abc"), 3) == 9);
+    REQUIRE(sut(std::string("abc"), 2) == 6);
+    REQUIRE(calls == 2);
+  }
+  SECTION("converting arguments share the key's entry") {
+    using fn = pure_function<std::size_t(std::string const&, int)>;
+    memoized<fn, 1024> sut(fn{length});
+    REQUIRE(sut(std::string("abcdef"), 2) == 12);
+    REQUIRE(sut("abcdef", 2) == 12);
+    REQUIRE(sut("abcdef", short(2)) == 12);
+    REQUIRE(calls == 1);
+    REQUIRE(sut.hits() == 2);
+  }
+  SECTION("two ways per set, least recently used is evicted") {
+    memoized<square_fn, 4, same_set> sut(square_fn{square});
+    sut(1);
+    sut(2);
+    sut(1);
+    sut(3);
+    REQUIRE(calls == 3);
+    sut(1);
+    REQUIRE(calls == 3);
+    sut(2);
+    REQUIRE(calls == 4);
+  }
+  SECTION("concurrent access") {
+    memoized<square_fn, 256> sut(square_fn{square});
+    std::atomic<int> wrong(0);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+      threads.emplace_back([&] {
+        for (auto idx = 0; idx < 10000; ++idx) {
+          auto const x = idx % 50;
+          if (sut(x) != x * x) ++wrong;
+        }
+      });
+    for (auto& t : threads) t.join();
+    REQUIRE(wrong == 0);
+    REQUIRE(sut.hits() + sut.misses() == 40000);
+    REQUIRE(sut.hits() > 30000);
+  }
+}
+}
@@ -0,0 +1,46 @@
+#include <archie/container/mirrored_ring.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <string>
+namespace {
+using namespace archie;
+TEST_CASE("mirrored_ring", "[ring]") {
+  mirrored_ring ring(1);
+  auto const capacity = ring.capacity();
+  REQUIRE(capacity > 0);
+  REQUIRE(ring.empty());
+  SECTION("emplace_back") {
+    ring.emplace_back('a');
+    ring.emplace_back('b');
+    REQUIRE(ring.size() == 2);
+    REQUIRE(std::string(ring.begin(), ring.end()) == "ab");
+  }
+  SECTION("emplace_back overwrites oldest") {
+    for (std::size_t idx = 0; idx < capacity; ++idx) ring.emplace_back('x');
+    ring.emplace_back('y');
+    REQUIRE(ring.size() == capacity);
+    REQUIRE(ring[0] == 'x');
+    REQUIRE(ring[capacity - 1] == 'y');
+  }
+  SECTION("read_window is contiguous across wraparound") {
+    std::string const filler(capacity - 3, '-');
+    REQUIRE(ring.write(filler.data(), filler.size()) == filler.size());
+    ring.commit(filler.size());
+    REQUIRE(ring.empty());
+    std::string const record = "wrapped record";
+    REQUIRE(ring.write(record.data(), record.size()) == record.size());
+    auto const w = ring.read_window();
+    REQUIRE(w.size() == record.size());
+    REQUIRE(std::string(w.begin(), w.end()) == record);
+    ring.commit(4);
+    REQUIRE(std::string(ring.begin(), ring.end()) == "ped record");
+  }
+  SECTION("write is bounded by free space") {
+    std::string const data(capacity + 10, 'z');
+    REQUIRE(ring.write(data.data(), data.size()) == capacity);
+    REQUIRE(ring.write_window().empty());
+    ring.commit(10);
+    REQUIRE(ring.write_window().size() == 10);
+  }
+}
+}
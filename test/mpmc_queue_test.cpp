@@ -0,0 +1,75 @@
+#include <archie/container/mpmc_queue.hpp>
+#include <catch.hpp>
+#include <resource.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+TEST_CASE("mpmc_queue", "[mpmc]") {
+  using sut = mpmc_queue<test::resource>;
+  SECTION("capacity is rounded up to power of two") {
+    REQUIRE(sut(1).capacity() == 2);
+    REQUIRE(sut(4).capacity() == 4);
+    REQUIRE(sut(5).capacity() == 8);
+  }
+  SECTION("fifo order") {
+    sut q(4);
+    REQUIRE(q.empty());
+    REQUIRE(q.try_emplace(1));
+    REQUIRE(q.try_push(test::resource(2)));
+    REQUIRE(q.size() == 2);
+    test::resource r;
+    REQUIRE(q.try_pop(r));
+    REQUIRE(r == 1);
+    REQUIRE(q.try_pop(r));
+    REQUIRE(r == 2);
+    REQUIRE_FALSE(q.try_pop(r));
+    REQUIRE(q.empty());
+  }
+  SECTION("bounded") {
+    sut q(4);
+    for (auto idx = 0; idx < 4; ++idx) REQUIRE(q.try_emplace(idx));
+    REQUIRE_FALSE(q.try_emplace(4));
+    test::resource r;
+    REQUIRE(q.try_pop(r));
+    REQUIRE(q.try_emplace(4));
+  }
+  SECTION("batch dequeue") {
+    sut q(8);
+    for (auto idx = 0; idx < 6; ++idx) REQUIRE(q.try_emplace(idx));
+    std::vector<test::resource> out;
+    REQUIRE(q.try_pop_n(std::back_inserter(out), 4) == 4);
+    REQUIRE(q.try_pop_n(std::back_inserter(out), 4) == 2);
+    REQUIRE(q.try_pop_n(std::back_inserter(out), 4) == 0);
+    REQUIRE(out.size() == 6);
+    for (auto idx = 0; idx < 6; ++idx) REQUIRE(out[static_cast<std::size_t>(idx)] == idx);
+  }
+}
+
+TEST_CASE("mpmc_queue concurrent", "[mpmc]") {
+  enum { producers = 4, consumers = 4, items = 10000 };
+  mpmc_queue<int> q(64);
+  std::atomic<long> sum(0);
+  std::atomic<int> popped(0);
+  std::vector<std::thread> threads;
+  for (auto p = 0; p < producers; ++p)
+    threads.emplace_back([&q] {
+      for (auto idx = 1; idx <= items; ++idx)
+        while (!q.try_push(idx)) std::this_thread::yield();
+    });
+  for (auto c = 0; c < consumers; ++c)
+    threads.emplace_back([&] {
+      int buff[8];
+      while (popped.load() < producers * items) {
+        auto const n = q.try_pop_n(buff, 8);
+        for (std::size_t idx = 0; idx < n; ++idx) sum += buff[idx];
+        popped += static_cast<int>(n);
+        if (n == 0) std::this_thread::yield();
+      }
+    });
+  for (auto& t : threads) t.join();
+  REQUIRE(sum.load() == static_cast<long>(producers) * items * (items + 1) / 2);
+  REQUIRE(q.empty());
+}
+}
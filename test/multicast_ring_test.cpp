@@ -0,0 +1,86 @@
+#include <archie/container/multicast_ring.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+TEST_CASE("multicast_ring", "[multicast]") {
+  multicast_ring<int> ring(4);
+  REQUIRE(ring.capacity() == 4);
+  auto const c0 = ring.add_consumer();
+  auto const c1 = ring.add_consumer({c0});
+  SECTION("every consumer sees every event") {
+    ring.emplace_back(1);
+    ring.emplace_back(2);
+    std::vector<int> seen;
+    REQUIRE(ring.available(c0) == 2);
+    REQUIRE(ring.consume(c0, [&seen](int x) { seen.push_back(x); }) == 2);
+    REQUIRE(ring.consume(c1, [&seen](int x) { seen.push_back(x); }) == 2);
+    REQUIRE((seen == std::vector<int>{1, 2, 1, 2}));
+  }
+  SECTION("dependent consumer waits for its dependency") {
+    ring.emplace_back(1);
+    REQUIRE(ring.available(c1) == 0);
+    REQUIRE(ring.consume(c0, [](int) {}) == 1);
+    REQUIRE(ring.available(c1) == 1);
+  }
+  SECTION("batch claim and backpressure") {
+    std::size_t first = 0;
+    REQUIRE(ring.try_claim(3, first));
+    REQUIRE(first == 0);
+    for (auto idx = 0; idx < 3; ++idx) ring[first + static_cast<std::size_t>(idx)] = idx;
+    ring.publish(first, 3);
+    REQUIRE(ring.try_claim(1, first));
+    REQUIRE_FALSE(ring.try_claim(1, first));
+    ring.publish(first);
+    REQUIRE(ring.consume(c0, [](int) {}, 2) == 2);
+    REQUIRE_FALSE(ring.try_claim(1, first));
+    REQUIRE(ring.consume(c1, [](int) {}) == 2);
+    REQUIRE(ring.try_claim(2, first));
+    REQUIRE(first == 4);
+  }
+  SECTION("limits are enforced") {
+    REQUIRE_THROWS_AS(ring.claim(5), std::length_error const&);
+    multicast_ring<int> small(4, 1);
+    small.add_consumer();
+    REQUIRE_THROWS_AS(small.add_consumer(), std::length_error const&);
+    auto const first = ring.add_consumer();
+    REQUIRE_THROWS_AS(ring.add_consumer({first + 1}), std::out_of_range const&);
+    REQUIRE_THROWS_AS(ring.add_consumer({first, 42}), std::out_of_range const&);
+    REQUIRE(ring.add_consumer({first}) == first + 1);
+  }
+}
+
+TEST_CASE("multicast_ring concurrent", "[multicast]") {
+  enum { items = 20000 };
+  multicast_ring<long> ring(64);
+  auto const persist = ring.add_consumer();
+  auto const metrics = ring.add_consumer();
+  auto const replicate = ring.add_consumer({persist});
+  std::atomic<bool> ordered(true);
+  auto const run = [&](std::size_t c, long& sum) {
+    long expected = 0;
+    while (expected < items) {
+      ring.consume(c, [&](long x) {
+        if (x != expected++) ordered = false;
+        if (c == replicate && ring.cursor(persist) < static_cast<std::size_t>(expected))
+          ordered = false;
+        sum += x;
+      });
+    }
+  };
+  long sums[3] = {0, 0, 0};
+  std::thread t0(run, persist, std::ref(sums[0]));
+  std::thread t1(run, metrics, std::ref(sums[1]));
+  std::thread t2(run, replicate, std::ref(sums[2]));
+  for (long idx = 0; idx < items; ++idx) ring.emplace_back(idx);
+  t0.join();
+  t1.join();
+  t2.join();
+  REQUIRE(ordered);
+  for (auto sum : sums) REQUIRE(sum == static_cast<long>(items) * (items - 1) / 2);
+}
+}
@@ -0,0 +1,159 @@
+#include <archie/object_pool.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+std::atomic<int> constructed{0};
+std::atomic<int> destroyed{0};
+
+struct context {
+  context() { ++constructed; }
+  explicit context(int v) : value(v) { ++constructed; }
+  ~context() { ++destroyed; }
+  int value = 0;
+  int uses = 0;
+};
+
+struct clear_uses {
+  void operator()(context& c) const { c.uses = 0; }
+};
+
+TEST_CASE("object_pool", "[object_pool]") {
+  constructed = 0;
+  destroyed = 0;
+  SECTION("checkout returns object on destruction") {
+    {
+      object_pool<context> pool(4, 2);
+      context* first = nullptr;
+      {
+        auto h = pool.checkout();
+        REQUIRE(*h != nullptr);
+        first = *h;
+        (*h)->uses = 3;
+      }
+      auto h = pool.checkout();
+      REQUIRE(*h == first);
+      REQUIRE((*h)->uses == 3);
+      REQUIRE(constructed == 1);
+      REQUIRE(pool.created() == 1);
+      auto const s = pool.stats();
+      REQUIRE(s.checkouts == 2);
+      REQUIRE(s.cache_hits == 1);
+      REQUIRE(s.returns == 1);
+    }
+    REQUIRE(destroyed == 1);
+  }
+  SECTION("reset hook runs on return") {
+    object_pool<context, clear_uses> pool(2);
+    {
+      auto h = pool.checkout();
+      (*h)->uses = 5;
+    }
+    auto h = pool.checkout();
+    REQUIRE((*h)->uses == 0);
+  }
+  SECTION("factory constructs objects") {
+    object_pool<context> pool(2, 8, object_pool<context>::factory([](void* p) {
+                                new (p) context(42);
+                              }));
+    auto h = pool.checkout();
+    REQUIRE((*h)->value == 42);
+  }
+  SECTION("throwing factory leaves the slot reusable") {
+    {
+      auto fail = true;
+      object_pool<context> pool(1, 2, object_pool<context>::factory([&fail](void* p) {
+                                  if (fail) throw std::runtime_error("factory");
+                                  new (p) context(7);
+                                }));
+      REQUIRE_THROWS_AS(pool.checkout(), std::runtime_error const&);
+      REQUIRE(pool.created() == 0);
+      fail = false;
+      auto h = pool.checkout();
+      REQUIRE(*h != nullptr);
+      REQUIRE((*h)->value == 7);
+      REQUIRE(pool.created() == 1);
+    }
+    REQUIRE(constructed == 1);
+    REQUIRE(destroyed == 1);
+  }
+  SECTION("capacity limit") {
+    object_pool<context> pool(3, 2);
+    std::vector<object_pool<context>::handle> held;
+    for (auto idx = 0; idx < 3; ++idx) held.push_back(pool.checkout());
+    auto none = pool.checkout();
+    REQUIRE(*none == nullptr);
+    REQUIRE(pool.stats().exhausted == 1);
+    held.clear();
+    for (auto idx = 0; idx < 3; ++idx) held.push_back(pool.checkout());
+    for (auto const& h : held) REQUIRE(*h != nullptr);
+    REQUIRE(pool.created() == 3);
+  }
+  SECTION("objects migrate through shared free list") {
+    object_pool<context> pool(8, 2);
+    std::vector<object_pool<context>::handle> held;
+    for (auto idx = 0; idx < 8; ++idx) held.push_back(pool.checkout());
+    held.clear();
+    auto missing = 0;
+    std::thread t([&pool, &missing] {
+      std::vector<object_pool<context>::handle> mine;
+      for (auto idx = 0; idx < 6; ++idx) mine.push_back(pool.checkout());
+      for (auto const& h : mine) missing += *h == nullptr ? 1 : 0;
+    });
+    t.join();
+    REQUIRE(missing == 0);
+    REQUIRE(pool.created() == 8);
+    REQUIRE(pool.stats().shared_hits > 0);
+  }
+  SECTION("objects cached by an exited thread return to the pool") {
+    object_pool<context> pool(4, 2);
+    std::thread t([&pool] {
+      std::vector<object_pool<context>::handle> mine;
+      for (auto idx = 0; idx < 4; ++idx) mine.push_back(pool.checkout());
+    });
+    t.join();
+    std::vector<object_pool<context>::handle> held;
+    for (auto idx = 0; idx < 4; ++idx) held.push_back(pool.checkout());
+    for (auto const& h : held) REQUIRE(*h != nullptr);
+    REQUIRE(pool.created() == 4);
+    REQUIRE(pool.stats().exhausted == 0);
+  }
+  SECTION("threads alternate between pools") {
+    object_pool<context> first(2, 2);
+    object_pool<context> second(2, 2);
+    for (auto n = 0; n < 100; ++n) {
+      auto a = first.checkout();
+      auto b = second.checkout();
+      REQUIRE(*a != nullptr);
+      REQUIRE(*b != nullptr);
+    }
+    REQUIRE(first.created() == 1);
+    REQUIRE(second.created() == 1);
+    REQUIRE(first.stats().cache_hits == 99);
+    REQUIRE(second.stats().cache_hits == 99);
+  }
+  SECTION("concurrent checkout never hands out an object twice") {
+    object_pool<context> pool(64, 4);
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+      threads.emplace_back([&pool, &errors] {
+        for (auto n = 0; n < 10000; ++n) {
+          auto a = pool.checkout();
+          auto b = pool.checkout();
+          if (*a == *b || ++(*a)->uses != 1 || ++(*b)->uses != 1) ++errors;
+          --(*a)->uses;
+          --(*b)->uses;
+        }
+      });
+    for (auto& t : threads) t.join();
+    REQUIRE(errors == 0);
+    REQUIRE(pool.created() <= 64);
+    REQUIRE(pool.stats().checkouts == 80000);
+  }
+}
+}
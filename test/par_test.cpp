@@ -0,0 +1,70 @@
+#include <archie/par.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+namespace {
+using namespace archie;
+
+TEST_CASE("par", "[par]") {
+  thread_pool pool(4, 64);
+  par::options opts;
+  opts.grain = 1000;
+  opts.serial_below = 5000;
+  opts.pool = &pool;
+  for (std::size_t const n : {0u, 1u, 999u, 4999u, 100000u}) {
+    heap_buffer<std::uint64_t> buff(n);
+    for (std::size_t idx = 0; idx < n; ++idx) buff.emplace_back((idx * 7919) % 1013);
+    std::vector<std::uint64_t> expected(buff.begin(), buff.end());
+    SECTION("for_each " + std::to_string(n)) {
+      par::for_each(buff, [](std::uint64_t& x) { x *= 2; }, opts);
+      for (std::size_t idx = 0; idx < n; ++idx) REQUIRE(buff[idx] == expected[idx] * 2);
+    }
+    SECTION("transform " + std::to_string(n)) {
+      std::vector<double> out(n);
+      par::transform(buff, out, [](std::uint64_t x) { return static_cast<double>(x) / 2; }, opts);
+      for (std::size_t idx = 0; idx < n; ++idx)
+        REQUIRE(out[idx] == static_cast<double>(expected[idx]) / 2);
+    }
+    SECTION("reduce " + std::to_string(n)) {
+      auto const sum = std::accumulate(expected.begin(), expected.end(), std::uint64_t(3));
+      REQUIRE(par::reduce(buff, std::uint64_t(3), opts) == sum);
+      auto const mx = par::reduce(
+          buff, std::uint64_t(0), [](std::uint64_t a, std::uint64_t b) { return std::max(a, b); },
+          opts);
+      REQUIRE(mx == (n > 0 ? *std::max_element(expected.begin(), expected.end()) : 0));
+    }
+    SECTION("inclusive_scan " + std::to_string(n)) {
+      std::vector<std::uint64_t> out(n);
+      par::inclusive_scan(buff, out, opts);
+      std::partial_sum(expected.begin(), expected.end(), expected.begin());
+      REQUIRE(out == expected);
+    }
+    SECTION("sort " + std::to_string(n)) {
+      par::sort(buff, opts);
+      std::sort(expected.begin(), expected.end());
+      REQUIRE(std::equal(buff.begin(), buff.end(), expected.begin(), expected.end()));
+      par::sort(buff, [](std::uint64_t a, std::uint64_t b) { return a > b; }, opts);
+      REQUIRE(std::is_sorted(buff.begin(), buff.end(), [](std::uint64_t a, std::uint64_t b) {
+        return a > b;
+      }));
+    }
+  }
+  SECTION("reduction order does not depend on thread count") {
+    std::vector<double> values(50000);
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
+      values[idx] = 1.0 / static_cast<double>(idx + 1);
+    thread_pool single(1, 64);
+    par::options serial = opts;
+    serial.serial_below = values.size() + 1;
+    auto const a = par::reduce(values, 0.0, opts);
+    opts.pool = &single;
+    auto const b = par::reduce(values, 0.0, opts);
+    auto const c = par::reduce(values, 0.0, serial);
+    REQUIRE(a == b);
+    REQUIRE(a == c);
+  }
+}
+}
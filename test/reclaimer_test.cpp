@@ -0,0 +1,92 @@
+#include <archie/reclaimer.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <thread>
+namespace {
+using namespace archie;
+
+std::atomic<int> freed{0};
+std::thread::id freed_on;
+std::size_t freed_size = 0;
+
+struct free_buffer {
+  void operator()(heap_buffer<int>& b) const {
+    freed_size = b.size();
+    b = heap_buffer<int>();
+    freed_on = std::this_thread::get_id();
+    ++freed;
+  }
+};
+
+struct count_close {
+  void operator()(int) const { ++freed; }
+};
+
+std::atomic<bool> gate{false};
+
+TEST_CASE("reclaimer", "[reclaimer]") {
+  freed = 0;
+  SECTION("deferred_deleter runs deleter on reclaimer thread") {
+    reclaimer r(16);
+    {
+      heap_buffer<int> b(3);
+      for (auto idx = 0; idx < 3; ++idx) b.emplace_back(idx);
+      resource<heap_buffer<int>, deferred_deleter<free_buffer>> res(
+          std::move(b), deferred_deleter<free_buffer>(r));
+    }
+    while (r.reclaimed() == 0) std::this_thread::yield();
+    REQUIRE(freed == 1);
+    REQUIRE(freed_size == 3);
+    REQUIRE(freed_on != std::this_thread::get_id());
+    REQUIRE(r.posted() == 1);
+    REQUIRE(r.reclaimed() == 1);
+    REQUIRE(r.inline_runs() == 0);
+  }
+  SECTION("composes with compact_resource") {
+    reclaimer r(16);
+    using handle = reserved_resource<int, deferred_deleter<count_close>, -1>;
+    {
+      handle const h1(3, deferred_deleter<count_close>(r));
+      handle const h2(4, deferred_deleter<count_close>(r));
+      handle const empty;
+    }
+    r.flush();
+    REQUIRE(freed == 2);
+  }
+  SECTION("full queue falls back to synchronous deletion") {
+    reclaimer r(2);
+    gate = false;
+    r.post([] {
+      while (!gate) std::this_thread::yield();
+    });
+    while (r.pending() != 0) std::this_thread::yield();
+    deferred_deleter<count_close> del(r);
+    del(1);
+    del(2);
+    REQUIRE(freed == 0);
+    del(3);
+    REQUIRE(freed == 1);
+    REQUIRE(r.inline_runs() == 1);
+    gate = true;
+    r.flush();
+    REQUIRE(freed == 3);
+    REQUIRE(r.reclaimed() == 3);
+  }
+  SECTION("oversized payload runs synchronously") {
+    basic_reclaimer<16> r(4);
+    char payload[64] = {};
+    REQUIRE_FALSE(r.post([payload] { freed += payload[0] + 1; }));
+    REQUIRE(freed == 1);
+    REQUIRE(r.inline_runs() == 1);
+  }
+  SECTION("destructor drains pending work") {
+    {
+      reclaimer r(16);
+      deferred_deleter<count_close> del(r);
+      for (auto idx = 0; idx < 10; ++idx) del(idx);
+    }
+    REQUIRE(freed == 10);
+  }
+}
+}
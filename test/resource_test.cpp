@@ -2,6 +2,8 @@
 #include <archie/alias.hpp>
 #include <catch.hpp>
 #include <functional>
+#include <utility>
+#include <vector>
 namespace {
 using namespace archie;
 
@@ -45,5 +47,79 @@ TEST_CASE("Can use resource", "[resource]") {
     }
     REQUIRE(i == 4);
   }
+
+  SECTION("Moved from resource is disengaged") {
+    int i = 0;
+    {
+      auto res = make_resource(alias(i), del);
+      auto other = std::move(res);
+      REQUIRE(i == 0);
+    }
+    REQUIRE(i == 1);
+  }
+}
+
+std::vector<int> closed;
+
+struct closer {
+  void operator()(int fd) const { closed.push_back(fd); }
+};
+
+struct counting_closer {
+  void operator()(int fd) { closed.push_back(fd + *offset); }
+  int* offset;
+};
+
+using handle = reserved_resource<int, closer, -1>;
+
+TEST_CASE("Can use compact_resource", "[resource]") {
+  closed.clear();
+  SECTION("Has the size of the handle") {
+    static_assert(sizeof(handle) == sizeof(int), "");
+    static_assert(sizeof(reserved_resource<void*, closer, nullptr>) == sizeof(void*), "");
+  }
+  SECTION("Default constructed is null") {
+    handle h;
+    REQUIRE(!h);
+    handle n(-1);
+    REQUIRE(!n);
+  }
+  SECTION("Deleter runs once") {
+    {
+      handle h(3);
+      REQUIRE(h);
+      REQUIRE(*h == 3);
+      handle moved(std::move(h));
+      REQUIRE(!h);
+      handle assigned;
+      assigned = std::move(moved);
+      REQUIRE(*assigned == 3);
+    }
+    REQUIRE(closed == std::vector<int>{3});
+  }
+  SECTION("Move assignment closes the target") {
+    {
+      handle a(1), b(2);
+      a = std::move(b);
+      REQUIRE(closed == std::vector<int>{1});
+    }
+    REQUIRE(closed == (std::vector<int>{1, 2}));
+  }
+  SECTION("Release and reset") {
+    handle h(4);
+    REQUIRE(h.release() == 4);
+    REQUIRE(!h);
+    handle g(5);
+    g = null_resource;
+    REQUIRE(closed == std::vector<int>{5});
+  }
+  SECTION("Stateful deleter is stored") {
+    int offset = 100;
+    {
+      reserved_resource<int, counting_closer, -1> h(1, counting_closer{&offset});
+      REQUIRE(sizeof(h) > sizeof(int));
+    }
+    REQUIRE(closed == std::vector<int>{101});
+  }
 }
 }
@@ -1,5 +1,6 @@
 #include <utility>
 #include <archie/container/ring_adapter.hpp>
+#include <archie/container/stack_buffer.hpp>
 
 #include <algorithm>
 #include <catch.hpp>
@@ -32,4 +33,69 @@ TEST_CASE("ring_adapter vector", "[ring]") {
     check(ring, idx + capacity + salt, static_cast<typename ring_t::size_type>(capacity));
   }
 }
+
+TEST_CASE("ring_adapter fifo", "[ring]") {
+  using ring_t = ring_adapter<stack_buffer<test::resource, 4>>;
+  ring_t ring;
+  SECTION("front and pop_front") {
+    ring.emplace_back(1);
+    ring.emplace_back(2);
+    REQUIRE(ring.front() == 1);
+    REQUIRE(ring.back() == 2);
+    ring.pop_front();
+    REQUIRE(ring.size() == 1);
+    REQUIRE(ring.front() == 2);
+    ring.pop_front();
+    REQUIRE(ring.empty());
+  }
+  SECTION("bounded deque reuses consumed slots") {
+    for (auto idx = 0; idx < 3; ++idx) ring.emplace_back(idx);
+    REQUIRE(ring.consume(2) == 2);
+    for (auto idx = 3; idx < 6; ++idx) ring.emplace_back(idx);
+    REQUIRE(ring.full());
+    REQUIRE(ring->size() == 4);
+    std::vector<int> values(std::begin(ring), std::end(ring));
+    REQUIRE((values == std::vector<int>{2, 3, 4, 5}));
+    ring.emplace_back(6);
+    REQUIRE(ring.front() == 3);
+    REQUIRE(ring.back() == 6);
+  }
+  SECTION("consume is bounded by size") {
+    ring.emplace_back(1);
+    REQUIRE(ring.consume(5) == 1);
+    REQUIRE(ring.empty());
+    ring.emplace_back(2);
+    REQUIRE(ring.front() == 2);
+  }
+  SECTION("drain_into") {
+    for (auto idx = 0; idx < 6; ++idx) ring.emplace_back(idx);
+    stack_buffer<test::resource, 3> out;
+    REQUIRE(ring.drain_into(out) == 3);
+    REQUIRE(out[0] == 2);
+    REQUIRE(out[2] == 4);
+    REQUIRE(ring.size() == 1);
+    REQUIRE(ring.front() == 5);
+  }
+  SECTION("pop_back") {
+    ring.emplace_back(1);
+    ring.emplace_back(2);
+    ring.pop_back();
+    ring.emplace_back(3);
+    REQUIRE(ring.size() == 2);
+    REQUIRE(ring.back() == 3);
+    REQUIRE(ring->size() == 2);
+  }
+  SECTION("watermarks") {
+    for (auto idx = 0; idx < 3; ++idx) ring.emplace_back(idx);
+    ring.consume(2);
+    REQUIRE(ring.high_watermark() == 3);
+    REQUIRE(ring.low_watermark() == 0);
+    ring.reset_watermarks();
+    REQUIRE(ring.high_watermark() == 1);
+    REQUIRE(ring.low_watermark() == 1);
+    ring.clear();
+    REQUIRE(ring.empty());
+    REQUIRE(ring.low_watermark() == 0);
+  }
+}
 }
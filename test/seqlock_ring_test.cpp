@@ -0,0 +1,51 @@
+#include <archie/container/seqlock_ring.hpp>
+#include <archie/container/heap_buffer.hpp>
+#include <archie/container/stack_buffer.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+TEST_CASE("seqlock_ring", "[ring]") {
+  seqlock_ring<stack_buffer<int, 4>> ring;
+  int out[4] = {};
+  REQUIRE(ring.snapshot(out) == 0);
+  SECTION("snapshot before wraparound") {
+    ring.emplace_back(1);
+    ring.emplace_back(2);
+    REQUIRE(ring.snapshot(out) == 2);
+    REQUIRE(out[0] == 1);
+    REQUIRE(out[1] == 2);
+  }
+  SECTION("snapshot joins both segments") {
+    for (auto idx = 0; idx < 6; ++idx) ring.emplace_back(idx);
+    REQUIRE(ring.snapshot(out) == 4);
+    REQUIRE((std::vector<int>(out, out + 4) == std::vector<int>{2, 3, 4, 5}));
+  }
+}
+
+TEST_CASE("seqlock_ring concurrent", "[ring]") {
+  struct sample {
+    long a;
+    long b;
+  };
+  seqlock_ring<heap_buffer<sample>> ring(8);
+  std::atomic<bool> stop(false);
+  std::atomic<bool> consistent(true);
+  std::thread reader([&] {
+    std::vector<sample> out(ring.capacity());
+    while (!stop) {
+      auto const n = ring.snapshot(out.data());
+      for (std::size_t idx = 0; idx < n; ++idx) {
+        if (out[idx].a != -out[idx].b) consistent = false;
+        if (idx > 0 && out[idx].a != out[idx - 1].a + 1) consistent = false;
+      }
+    }
+  });
+  for (long idx = 0; idx < 100000; ++idx) ring.emplace_back(sample{idx, -idx});
+  stop = true;
+  reader.join();
+  REQUIRE(consistent);
+}
+}
@@ -0,0 +1,112 @@
+#include <archie/thread_pool.hpp>
+#include <catch.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+namespace {
+using namespace archie;
+
+TEST_CASE("work_stealing_deque", "[thread_pool]") {
+  using sut = work_stealing_deque<int>;
+  SECTION("owner is lifo, thief is fifo") {
+    sut d(4);
+    REQUIRE(d.capacity() == 4);
+    REQUIRE(d.empty());
+    for (auto idx = 0; idx < 4; ++idx) REQUIRE(d.push(idx));
+    REQUIRE_FALSE(d.push(4));
+    REQUIRE(d.size() == 4);
+    int x = -1;
+    REQUIRE(d.pop(x));
+    REQUIRE(x == 3);
+    REQUIRE(d.steal(x));
+    REQUIRE(x == 0);
+    REQUIRE(d.pop(x));
+    REQUIRE(x == 2);
+    REQUIRE(d.pop(x));
+    REQUIRE(x == 1);
+    REQUIRE_FALSE(d.pop(x));
+    REQUIRE_FALSE(d.steal(x));
+    REQUIRE(d.empty());
+  }
+  SECTION("every item is taken once") {
+    constexpr int count = 100000;
+    sut d(256);
+    std::vector<std::atomic<int>> seen(count);
+    for (auto& s : seen) s = 0;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for (auto t = 0; t < 3; ++t)
+      thieves.emplace_back([&] {
+        int x = 0;
+        while (!done)
+          if (d.steal(x)) ++seen[static_cast<std::size_t>(x)];
+      });
+    int x = 0;
+    for (auto idx = 0; idx < count; ++idx) {
+      while (!d.push(idx))
+        if (d.pop(x)) ++seen[static_cast<std::size_t>(x)];
+      if (idx % 3 == 0 && d.pop(x)) ++seen[static_cast<std::size_t>(x)];
+    }
+    while (d.pop(x)) ++seen[static_cast<std::size_t>(x)];
+    done = true;
+    for (auto& t : thieves) t.join();
+    for (auto& s : seen) REQUIRE(s == 1);
+  }
+}
+
+void bump(std::atomic<int>* const& counter, int const& n) { *counter += n; }
+
+void fill(std::size_t first, std::size_t last, std::uint32_t* const& out) {
+  for (; first != last; ++first) out[first] = static_cast<std::uint32_t>(first);
+}
+
+void nested(thread_pool* const& pool, std::atomic<int>* const& counter) {
+  wait_group wg;
+  for (auto idx = 0; idx < 8; ++idx) pool->submit(wg, bump, counter, 1);
+  pool->wait(wg);
+}
+
+TEST_CASE("thread_pool", "[thread_pool]") {
+  thread_pool pool(4, 64);
+  REQUIRE(pool.size() == 4);
+  SECTION("submit with wait_group") {
+    std::atomic<int> counter(0);
+    wait_group wg;
+    for (auto idx = 0; idx < 1000; ++idx) pool.submit(wg, bump, &counter, 2);
+    pool.wait(wg);
+    REQUIRE(wg.pending() == 0);
+    REQUIRE(counter == 2000);
+  }
+  SECTION("tasks submit tasks") {
+    std::atomic<int> counter(0);
+    wait_group wg;
+    for (auto idx = 0; idx < 16; ++idx) pool.submit(wg, nested, &pool, &counter);
+    pool.wait(wg);
+    REQUIRE(counter == 16 * 8);
+  }
+  SECTION("tasks submit into another pool") {
+    thread_pool other(2, 64);
+    std::atomic<int> counter(0);
+    wait_group wg;
+    for (auto idx = 0; idx < 16; ++idx) pool.submit(wg, nested, &other, &counter);
+    pool.wait(wg);
+    REQUIRE(counter == 16 * 8);
+  }
+  SECTION("parallel_for covers the range") {
+    std::vector<std::uint32_t> out(100000, ~0u);
+    pool.parallel_for(0, out.size(), fill, out.data());
+    for (std::size_t idx = 0; idx < out.size(); ++idx) REQUIRE(out[idx] == idx);
+    pool.parallel_for(5, 5, fill, out.data());
+  }
+  SECTION("stats") {
+    std::atomic<int> counter(0);
+    wait_group wg;
+    for (auto idx = 0; idx < 100; ++idx) pool.submit(wg, bump, &counter, 1);
+    pool.wait(wg);
+    std::uint64_t executed = 0;
+    for (std::size_t idx = 0; idx < pool.size(); ++idx) executed += pool.stats(idx).executed;
+    REQUIRE(executed <= 100);
+  }
+}
+}
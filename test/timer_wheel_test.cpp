@@ -0,0 +1,88 @@
+#include <archie/timer_wheel.hpp>
+#include <catch.hpp>
+#include <map>
+#include <random>
+#include <vector>
+namespace {
+using namespace archie;
+
+std::vector<std::pair<std::uint64_t, std::uint64_t>> fired;
+timer_wheel<3, 3>* wheel = nullptr;
+
+void on_timer(std::uint64_t arg) { fired.emplace_back(wheel->now(), arg); }
+timer_wheel<3, 3>::callback const record{on_timer};
+
+TEST_CASE("timer_wheel", "[timer_wheel]") {
+  timer_wheel<3, 3> tw(16);
+  wheel = &tw;
+  fired.clear();
+  SECTION("fires at deadline") {
+    tw.schedule(3, record, 1);
+    tw.schedule(1, record, 2);
+    REQUIRE(tw.size() == 2);
+    REQUIRE(tw.advance(2) == 1);
+    REQUIRE(tw.advance(10) == 1);
+    REQUIRE((fired == std::vector<std::pair<std::uint64_t, std::uint64_t>>{{1, 2}, {3, 1}}));
+    REQUIRE(tw.empty());
+  }
+  SECTION("cascades from upper levels") {
+    tw.schedule(70, record, 1);
+    tw.schedule(9, record, 2);
+    tw.schedule(600, record, 3);
+    tw.advance(1000);
+    REQUIRE(fired.size() == 3);
+    REQUIRE(fired[0] == std::make_pair(std::uint64_t(9), std::uint64_t(2)));
+    REQUIRE(fired[1] == std::make_pair(std::uint64_t(70), std::uint64_t(1)));
+    REQUIRE(fired[2] == std::make_pair(std::uint64_t(600), std::uint64_t(3)));
+  }
+  SECTION("cancel") {
+    auto const id = tw.schedule(5, record, 1);
+    REQUIRE(id);
+    REQUIRE(tw.cancel(id));
+    REQUIRE_FALSE(tw.cancel(id));
+    tw.advance(10);
+    REQUIRE(fired.empty());
+  }
+  SECTION("overdue timers fire on next tick") {
+    tw.advance(5);
+    tw.schedule(2, record, 1);
+    tw.advance(6);
+    REQUIRE(fired.size() == 1);
+    REQUIRE(fired[0].first == 6);
+  }
+  SECTION("capacity is bounded") {
+    for (auto idx = 0; idx < 16; ++idx) REQUIRE(tw.schedule(100, record));
+    REQUIRE_FALSE(tw.schedule(100, record));
+  }
+}
+
+TEST_CASE("timer_wheel matches reference", "[timer_wheel]") {
+  timer_wheel<3, 3> tw(256);
+  wheel = &tw;
+  fired.clear();
+  std::mt19937 gen(7);
+  std::multimap<std::uint64_t, std::uint64_t> expected;
+  std::vector<timer_wheel<3, 3>::timer_id> ids;
+  for (std::uint64_t idx = 0; idx < 200; ++idx) {
+    auto const deadline = 1 + gen() % 2000;
+    ids.push_back(tw.schedule(deadline, record, idx));
+    expected.emplace(deadline, idx);
+  }
+  for (std::uint64_t idx = 0; idx < 200; idx += 3) {
+    REQUIRE(tw.cancel(ids[idx]));
+    for (auto it = expected.begin(); it != expected.end(); ++it)
+      if (it->second == idx) {
+        expected.erase(it);
+        break;
+      }
+  }
+  tw.advance(3000);
+  REQUIRE(fired.size() == expected.size());
+  for (auto const& f : fired) {
+    auto const range = expected.equal_range(f.first);
+    bool found = false;
+    for (auto it = range.first; it != range.second; ++it) found |= it->second == f.second;
+    REQUIRE(found);
+  }
+}
+}
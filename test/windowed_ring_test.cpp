@@ -0,0 +1,44 @@
+#include <archie/container/windowed_ring.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+namespace {
+using namespace archie;
+TEST_CASE("windowed_ring", "[ring]") {
+  using sut = windowed_ring<int, window::sum, window::mean, window::min, window::max>;
+  sut w(3);
+  REQUIRE(w.empty());
+  REQUIRE(w.capacity() == 3);
+  SECTION("aggregates before window fills") {
+    w.emplace_back(4);
+    w.emplace_back(2);
+    REQUIRE(w.sum() == 6);
+    REQUIRE(w.mean() == Approx(3.0));
+    REQUIRE(w.min() == 2);
+    REQUIRE(w.max() == 4);
+  }
+  SECTION("aggregates match recomputation over sliding window") {
+    std::vector<int> const samples = {5, 1, 7, 3, 3, 9, 2, 8, 8, 0, 4, 6};
+    for (auto x : samples) {
+      w.emplace_back(x);
+      std::vector<int> const window(w.begin(), w.end());
+      REQUIRE(w.sum() == std::accumulate(window.begin(), window.end(), 0));
+      REQUIRE(w.mean() ==
+              Approx(static_cast<double>(w.sum()) / static_cast<double>(window.size())));
+      REQUIRE(w.min() == *std::min_element(window.begin(), window.end()));
+      REQUIRE(w.max() == *std::max_element(window.begin(), window.end()));
+    }
+    REQUIRE(w.size() == 3);
+  }
+}
+
+TEST_CASE("windowed_ring with single aggregate", "[ring]") {
+  windowed_ring<double, window::max> w(2);
+  w.emplace_back(1.5);
+  w.emplace_back(0.5);
+  REQUIRE(w.max() == Approx(1.5));
+  w.emplace_back(0.25);
+  REQUIRE(w.max() == Approx(0.5));
+}
+}